@@ -16,4 +16,4 @@ mkdir -p bin/linux
 
 # Compiling
 echo "Compiling..."
-${CXX} -O3 -o bin/linux/galamake src/*.cpp -Iinclude -Llib/linux -lxdt -lraylib --std=c++17
\ No newline at end of file
+${CXX} -O3 -o bin/linux/galamake src/*.cpp -Iinclude -Llib/linux -lxdt -lraylib -pthread --std=c++17
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+#include <GalaMake/Checking.hpp>
+#include <GalaMake/Jobs.hpp>
+#include <GalaMake/Trimming.hpp>
+
+#define GALAMAKE_ATLAS_DIR          "atlases/"
+#define GALAMAKE_ATLAS_DEFAULT_SIZE 2048    // Largest page size, unless 'build_options.atlas_size' says otherwise.
+#define GALAMAKE_ATLAS_PADDING      1       // Empty pixels kept between images, so filtering doesn't bleed.
+
+// Where a resource's texture ended up within an atlas page.
+struct AtlasPlacement {
+    std::string page; // Atlas page name, "page_<n>".
+    int x, y, width, height;
+
+    std::vector<SpriteFrame> frames; // Trimmed sprites only: frames within the placement.
+};
+
+// MaxRects bin packer (best short side fit), after Jukka Jylänki's
+// "A Thousand Ways to Pack the Bin".
+class MaxRectsPacker {
+    private:
+        struct Rect {
+            int x, y, width, height;
+        };
+
+        int binWidth, binHeight;
+        int usedWidth = 0, usedHeight = 0;
+        std::vector<Rect> freeRects;
+
+        void SplitFreeRects(const Rect &used);
+        void PruneFreeRects();
+    public:
+        bool Insert(int width, int height, int &x, int &y);
+
+        // Smallest width and height covering everything inserted so far.
+        void GetUsedSize(int &width, int &height) const;
+
+        MaxRectsPacker(int width, int height);
+};
+
+std::string GetAtlasDirectory(const json &buildConfig);
+std::string GetAtlasPagePath(const json &buildConfig, const std::string &page);
+std::vector<std::string> ScanAtlasPages(const json &buildConfig);
+
+// Removes every built atlas page, so none are left behind for packing.
+void ClearAtlasPages(const json &buildConfig);
+
+// Packs the textures of the given sprites and nslices into power-of-two atlas
+// pages (one set of pages per 'texture_filter'), and builds each page as an
+// 'atlas' resource. Sprites with 'trim' are trimmed first. Textures too large for a page are left out. Returns where
+// each packed resource's texture went, keyed by resource URI.
+bool BuildAtlases(
+    const json &buildConfig,
+    const std::vector<ValidatedResource> &resources,
+    int maxSize,
+    JobPool &pool,
+    std::map<std::string, AtlasPlacement> &placements
+);
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+
+struct AudioInfo {
+    unsigned int channels   = 0;
+    unsigned int sampleRate = 0;
+    unsigned int sampleSize = 0; // Bits per sample (as decoded).
+    uint64_t     frameCount = 0;
+};
+
+// Header-only validation: these read the format headers (and, for Vorbis,
+// the last page's granule position) without decoding any samples.
+bool ProbeWaveFile   (const std::string &path, AudioInfo &info);
+bool ProbeVorbisFile (const std::string &path, AudioInfo &info);
+
+bool ProbeAudioFile(const std::string &path, AudioInfo &info);
+
+// Full validation: decodes the entire stream.
+bool DecodeAudioFile(const std::string &path, AudioInfo &info);
+
+// Decoded audio, as interleaved samples in [-1, 1].
+struct AudioSamples {
+    std::vector<float> samples;
+    unsigned int channels   = 0;
+    unsigned int sampleRate = 0;
+    uint64_t     frameCount = 0;
+};
+
+bool LoadAudioSamples(const std::string &path, AudioSamples &audio);
+
+enum class WaveEncoding {
+    PCM8,
+    PCM16,
+    IMAADPCM // 4 bits per sample, GALAMAKE_ADPCM_BLOCK_SIZE bytes per channel per block.
+};
+
+#define GALAMAKE_ADPCM_BLOCK_SIZE    512
+#define GALAMAKE_PREDECODE_WARN_SIZE (256 * 1024) // Predecoded sounds larger than this are warned about.
+
+bool GetWaveEncodingFromString(const std::string &str, WaveEncoding &encoding);
+std::string GetWaveEncodingString(WaveEncoding encoding);
+
+// Raw interleaved samples, as raylib's Wave holds them: 8-bit unsigned or
+// 16-bit signed little-endian.
+std::vector<uint8_t> GetPCMBytes(const AudioSamples &audio, unsigned int sampleSize);
+
+// A complete '.wav' file, which raylib (dr_wav) loads as is.
+std::vector<uint8_t> EncodeWave(const AudioSamples &audio, WaveEncoding encoding);
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+#include <GalaMake/Compression.hpp>
+#include <GalaMake/QOI.hpp>
+
+#define GALAMAKE_BENCHMARK_MIN_TIME 0.25 // Seconds each measurement is repeated for (at least).
+
+struct BenchmarkResult {
+    std::string name;
+    size_t inputBytes = 0;
+    size_t outputBytes = 0;
+    size_t decodedBytes = 0; // Inputs that could be encoded (and so decoded).
+    double encodeSecs = 0.0; // Per pass over the inputs.
+    double decodeSecs = 0.0;
+    bool verified = true;    // Every input decoded back to itself.
+};
+
+struct ImageSample {
+    std::vector<uint8_t> pixels;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+};
+
+BenchmarkResult BenchmarkCompression(const std::vector<std::vector<uint8_t>> &samples, Compression compression);
+BenchmarkResult BenchmarkQOI(const std::vector<ImageSample> &samples, QOIPath path); // Also checks output against the scalar path.
+
+void PrintBenchmarkResults(const std::vector<std::pair<std::string, BenchmarkResult>> &results);
\ No newline at end of file
@@ -1,12 +1,43 @@
 #pragma once
 
 #include <GalaMake/Common.hpp>
+#include <GalaMake/GresTable.hpp>
+#include <GalaMake/Checking.hpp>
+#include <GalaMake/Atlas.hpp>
+#include <GalaMake/Audio.hpp>
+#include <GalaMake/Jobs.hpp>
 
-bool BuildTextureResource (const ResourceInfo &resource);
-bool BuildSpriteResource  (const ResourceInfo &resource);
-bool BuildTilesetResource (const ResourceInfo &resource);
-bool BuildNSliceResource  (const ResourceInfo &resource);
-bool BuildSoundResource   (const ResourceInfo &resource);
-bool BuildFontResource    (const ResourceInfo &resource);
+// Sprite frame table layout. Version 1 (no 'frames_version' item) stored
+// each frame as separate 'frame[i].x/y/w/h' items.
+#define GALAMAKE_SPRITE_FRAMES_VERSION  2
+#define GALAMAKE_SPRITE_FRAME_SIZE      8
+#define GALAMAKE_SPRITE_TRIM_SIZE       8
 
-bool BuildResource(const ResourceInfo &resource);
\ No newline at end of file
+struct BuildOptions {
+    bool deepVerify = false; // Fully decode sounds to verify them, rather than only reading their headers.
+    std::map<ResourceType, Compression> compression; // Per resource type ('build_options.compression'); none if missing.
+
+    bool atlas = false; // Pack sprite and nslice textures into shared atlas pages.
+    int atlasSize = GALAMAKE_ATLAS_DEFAULT_SIZE; // 'build_options.atlas_size'.
+    std::map<std::string, AtlasPlacement> atlasPlacements; // Filled in by BuildAtlases(), keyed by resource URI.
+
+    size_t predecodeWarnSize = GALAMAKE_PREDECODE_WARN_SIZE; // 'build_options.predecode_warn_size', in bytes.
+
+    JobPool *pool = nullptr; // The build's pool, for builders which split up their own work. Run in turn if null.
+};
+
+bool ReadBuildOptions(const json &buildConfig, BuildOptions &options);
+std::string GetBuildOptionsKey(const BuildOptions &options); // Changes whenever the options would change built files.
+
+const AtlasPlacement *GetAtlasPlacement(const BuildOptions &options, const ResourceInfo &resource);
+
+// Builders may leave a short note (e.g. what an optimisation saved) for the
+// build output, and sound builds a warning (e.g. a predecoded sound too large).
+bool BuildTextureResource (const ValidatedResource &resource, const BuildOptions &options = {}, std::string *note = nullptr);
+bool BuildSpriteResource  (const ValidatedResource &resource, const BuildOptions &options = {}, std::string *note = nullptr);
+bool BuildTilesetResource (const ValidatedResource &resource, const BuildOptions &options = {}, std::string *note = nullptr);
+bool BuildNSliceResource  (const ValidatedResource &resource, const BuildOptions &options = {}, std::string *note = nullptr);
+bool BuildSoundResource   (const ValidatedResource &resource, const BuildOptions &options = {}, std::string *note = nullptr, std::string *warning = nullptr);
+bool BuildFontResource    (const ValidatedResource &resource, const BuildOptions &options = {}, std::string *note = nullptr);
+
+bool BuildResource(const ValidatedResource &resource, const BuildOptions &options = {}, std::string *note = nullptr, std::string *warning = nullptr);
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+
+#include <mutex>
+
+#define GALAMAKE_CACHE_DIR  ".galamake/"
+#define GALAMAKE_CACHE_NAME GALAMAKE_CACHE_DIR "cache"
+
+std::vector<std::string> GetResourceInputFiles(const ResourceInfo &resource);
+
+// Persistent record of each resource's inputs as of its last successful build.
+// Inputs are compared by size and modification time first, and only hashed
+// when those differ.
+class BuildCache {
+    private:
+        json entries;
+        std::string buildKey;
+        std::mutex mutex;
+        bool modified = false;
+    public:
+        bool IsUpToDate (const ResourceInfo &resource);
+        bool Update     (const ResourceInfo &resource);
+        void Invalidate (const ResourceInfo &resource);
+
+        // Entries saved under another build key (see GetBuildOptionsKey) are dropped.
+        bool Load(const std::string &filename, const std::string &buildKey = "");
+        bool Save(const std::string &filename);
+
+        BuildCache();
+};
+
+// Content-addressed store of built '.gres' files, in a directory which may be
+// shared between machines ('build_options.shared_cache_dir'). Files are keyed
+// by a hash of the resource type, the contents of all its input files, the
+// GalaMake version and the build key, so any machine building the same inputs
+// the same way can take the stored result instead.
+class SharedCache {
+    private:
+        std::string directory;
+        std::string buildKey;
+
+        std::string GetEntryPath(const std::string &key) const;
+    public:
+        bool Open(const std::string &directory, const std::string &buildKey = "");
+        bool IsOpen() const;
+
+        bool GetKey(const ResourceInfo &resource, std::string &key) const;
+
+        // Fetch copies (or reflinks) a stored file to the resource's output path.
+        bool Fetch(const std::string &key, const ResourceInfo &resource) const;
+        bool Store(const std::string &key, const ResourceInfo &resource) const;
+};
+
+std::string GetSharedCacheDirectory(const json &buildConfig); // Empty if not configured.
\ No newline at end of file
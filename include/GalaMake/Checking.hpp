@@ -10,13 +10,26 @@ enum class ResourceCheckError {
     InvalidContent
 };
 
+// Result of checking a resource: its parsed 'resource.json', and the paths of
+// the content files it is built from (keyed "config", "license", "texture",
+// "audio" or "font"). Builders take this, so nothing is read or parsed twice.
+struct ValidatedResource {
+    ResourceInfo info;
+    json config;
+    std::map<std::string, std::string> contentPaths;
+
+    std::string failedField; //!< Config field (or file) which failed the check, if any.
+};
+
 std::string GetResourceCheckErrorString(const ResourceCheckError &error);
+std::string GetResourceCheckErrorString(const ResourceCheckError &error, const std::string &failedField);
 
-ResourceCheckError CheckTextureResourceIntegrity (const ResourceInfo &resource);
-ResourceCheckError CheckSpriteResourceIntegrity  (const ResourceInfo &resource);
-ResourceCheckError CheckTilesetResourceIntegrity (const ResourceInfo &resource);
-ResourceCheckError CheckNSliceResourceIntegrity  (const ResourceInfo &resource);
-ResourceCheckError CheckSoundResourceIntegrity   (const ResourceInfo &resource);
-ResourceCheckError CheckFontResourceIntegrity    (const ResourceInfo &resource);
+ResourceCheckError CheckTextureResourceIntegrity (const ResourceInfo &resource, ValidatedResource &validated);
+ResourceCheckError CheckSpriteResourceIntegrity  (const ResourceInfo &resource, ValidatedResource &validated);
+ResourceCheckError CheckTilesetResourceIntegrity (const ResourceInfo &resource, ValidatedResource &validated);
+ResourceCheckError CheckNSliceResourceIntegrity  (const ResourceInfo &resource, ValidatedResource &validated);
+ResourceCheckError CheckSoundResourceIntegrity   (const ResourceInfo &resource, ValidatedResource &validated);
+ResourceCheckError CheckFontResourceIntegrity    (const ResourceInfo &resource, ValidatedResource &validated);
 
-ResourceCheckError CheckResourceIntegrity(const ResourceInfo &resource);
\ No newline at end of file
+ResourceCheckError CheckResourceIntegrity(const ResourceInfo &resource, ValidatedResource &validated);
+ResourceCheckError CheckResourceIntegrity(const ResourceInfo &resource);
@@ -6,6 +6,7 @@
 #include <libxdt.hpp>
 #include <raylib.h>
 
+#define GALAMAKE_VERSION     "1.0.0"
 #define GALAMAKE_CONFIG_NAME "GalaMake.json"
 
 using json = nlohmann::ordered_json;
@@ -18,7 +19,10 @@ enum class ToolError {
     InvalidConfig,
     ResourceNotFound,
     InvalidResourceType,
-    InvalidResourceData
+    InvalidResourceData,
+    InvalidOption,
+    ResourceNotBuilt,
+    WatchUnavailable
 };
 
 enum class ResourceType {
@@ -68,6 +72,22 @@ static json g_defaultBuildConfig = {
     {"build_options", {
         {"workspace_dir", "./workspace/"},
         {"output_dir", "./resources/"},
-        {"use_cache", true}
+        {"use_cache", true},
+        {"compression", {
+            {"texture", "none"},
+            {"sprite",  "none"},
+            {"tileset", "none"},
+            {"nslice",  "none"},
+            {"sound",   "none"},
+            {"font",    "none"}
+        }}
     }}
-};
\ No newline at end of file
+};
+
+// Build options with no default value. 'repair' keeps these when they are valid.
+static std::vector<std::string> g_optionalBuildOptions = {
+    "pack_file",
+    "atlas_size",
+    "shared_cache_dir",
+    "predecode_warn_size"
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+
+#define GALAMAKE_COMPRESSION_SHIFT      6           // Position of the 2-bit field in xdt::ItemFlags::low.
+#define GALAMAKE_COMPRESSION_MIN_SIZE   256         // Smaller items aren't worth compressing.
+#define GALAMAKE_DEFLATE_MAX_SIZE       (64 << 20)  // raylib's DecompressData limit.
+
+// Item compression schemes, as numbered by the XDT specification.
+//
+// Payload formats:
+//   RLE:       {byte, run length} pairs, as read by xdt::DecompressRLE.
+//   LZ77:      u32 little-endian decompressed size, then an LZ4 block
+//              (token, literals, u16 little-endian offset, match length).
+//   DEFLATE:   u32 little-endian decompressed size, then a raw DEFLATE
+//              stream (RFC 1951), as from raylib's CompressData.
+//
+// There are no levels: LZ77 is the fast (LZ4-class) end and DEFLATE the
+// high-ratio end, standing in for zstd (which would be a new dependency).
+// raylib fixes its DEFLATE quality when it is built.
+enum class Compression {
+    None    = 0b00,
+    RLE     = 0b01,
+    LZ77    = 0b10,
+    Deflate = 0b11
+};
+
+bool GetCompressionFromString(const std::string &str, Compression &compression);
+std::string GetCompressionString(Compression compression);
+
+Compression GetItemCompression(const xdt::ItemFlags &flags);
+void SetItemCompression(xdt::ItemFlags &flags, Compression compression);
+
+// Both return false when the data can't be (de)compressed with the scheme.
+bool CompressBytes  (const uint8_t *data, size_t size, Compression compression, std::vector<uint8_t> &out);
+bool DecompressBytes(const uint8_t *data, size_t size, Compression compression, std::vector<uint8_t> &out);
\ No newline at end of file
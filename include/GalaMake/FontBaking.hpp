@@ -0,0 +1,58 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+#include <GalaMake/Jobs.hpp>
+
+#define GALAMAKE_FONT_GLYPH_SIZE     18     // int32 codepoint, int16 {x, y, w, h, offset_x, offset_y, advance_x}.
+#define GALAMAKE_FONT_KERNING_SIZE   10     // int32 first, int32 second (codepoints), int16 amount (pixels).
+#define GALAMAKE_FONT_GLYPH_PADDING  4      // As raylib's LoadFontEx.
+#define GALAMAKE_FONT_MAX_CODEPOINTS 65536
+#define GALAMAKE_FONT_SDF_SIZE       48     // Size SDF glyphs are generated at, unless 'sizes' says otherwise.
+#define GALAMAKE_FONT_BAKE_CHUNK     64     // Glyphs rasterised per job.
+
+struct BakedGlyph {
+    int codepoint;
+    int x, y, width, height; // Within the atlas.
+    int offsetX, offsetY, advanceX;
+};
+
+struct KerningPair {
+    int first, second; // Codepoints.
+    int amount;        // Pixels, added to the first glyph's advance.
+};
+
+// One font size, rasterised: a QOI atlas (white, with coverage, or distance
+// for SDF fonts, as alpha, like raylib's font atlases), each glyph's place and metrics in it, and the
+// non-zero kerning between every pair of its glyphs. Both tables are sorted
+// by codepoint, for binary searching.
+struct BakedFont {
+    int size = 0;
+    bool sdf = false;
+    int glyphPadding = 0;
+    std::vector<uint8_t> atlasData;
+    std::vector<BakedGlyph> glyphs;
+    std::vector<KerningPair> kerning;
+};
+
+// Codepoints listed by a font's 'codepoints' (numbers, or [first, last]
+// ranges), sorted and without repeats. Printable ASCII if there are none.
+std::vector<int> GetFontCodepoints(const json &fontConfig);
+
+// Adds every character in a UTF-8 text file (e.g. the game's localisation
+// strings, as listed by a font's 'codepoint_sources') to a sorted codepoint
+// list, keeping it sorted and without repeats. Control characters and
+// malformed sequences are skipped.
+bool AddTextCodepoints(const std::string &path, std::vector<int> &codepoints);
+
+// Font sizes to bake: 'sizes', or GALAMAKE_FONT_SDF_SIZE alone for SDF fonts
+// without any. Empty if nothing is to be baked.
+std::vector<int> GetFontSizes(const json &fontConfig);
+
+// Glyphs are rasterised a chunk per job, on the given pool (in turn, if
+// null). SDF glyphs are single channel signed distance fields (raylib's
+// FONT_SDF), which scale to any size. Codepoints the font has no glyph for
+// are left out.
+bool BakeFont(const std::vector<uint8_t> &fontData, int size, const std::vector<int> &codepoints, bool sdf, JobPool *pool, BakedFont &baked);
+
+std::vector<uint8_t> GetGlyphTableBytes(const std::vector<BakedGlyph> &glyphs);
+std::vector<uint8_t> GetKerningTableBytes(const std::vector<KerningPair> &kerning);
\ No newline at end of file
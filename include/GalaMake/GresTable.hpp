@@ -0,0 +1,74 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+#include <GalaMake/Compression.hpp>
+
+#include <unordered_map>
+
+// Builder-side stand-in for xdt::Table.
+// Items keep their insertion order (which is also their serialised order),
+// and a hash index over item names makes lookups and inserts O(1), where
+// xdt::Table scans its whole directory for every call.
+// Blobs can be moved in, referenced in place, or streamed from a file (see
+// SetBytes, SetBytesFromFile), and Save writes them straight from where they
+// live, without building the whole serialised table in memory first.
+class GresTable {
+    private:
+        struct ExternalBlob {
+            const uint8_t *data;
+            size_t size;
+            std::string path; // Read from here at save time, if not empty.
+        };
+
+        std::vector<std::pair<std::string, xdt::Item>> directory;
+        std::unordered_map<std::string, size_t> index;
+        std::unordered_map<std::string, ExternalBlob> externalBlobs;
+
+        xdt::Item &FindOrAddItem(const std::string &itemName, bool &added);
+        bool CanSetBytes(const xdt::Item &item, bool isFileData, bool overwriteType) const;
+        void ReleaseExternalBlob(const std::string &itemName, const xdt::Item &item);
+    public:
+        xdt::HeaderInfo headerInfo;
+
+        // General item stuff
+        xdt::Item       *GetItem    (const std::string &itemName);
+        bool            ItemExists  (const std::string &itemName) const;
+        xdt::ItemType   GetItemType (const std::string &itemName) const;
+        void            DeleteItem  (const std::string &itemName);
+        size_t          GetItemCount() const;
+
+        const std::vector<std::pair<std::string, xdt::Item>> &GetDirectory() const;
+
+        // Setters
+        void SetByte      (const std::string &itemName, uint8_t  value, bool overwriteType = false);
+        void SetBool      (const std::string &itemName, bool     value, bool overwriteType = false);
+        void SetInt16     (const std::string &itemName, int16_t  value, bool overwriteType = false);
+        void SetUint16    (const std::string &itemName, uint16_t value, bool overwriteType = false);
+        void SetInt32     (const std::string &itemName, int32_t  value, bool overwriteType = false);
+        void SetUint32    (const std::string &itemName, uint32_t value, bool overwriteType = false);
+        void SetInt64     (const std::string &itemName, int64_t  value, bool overwriteType = false);
+        void SetUint64    (const std::string &itemName, uint64_t value, bool overwriteType = false);
+        void SetFloat     (const std::string &itemName, float    value, bool overwriteType = false);
+        void SetDouble    (const std::string &itemName, double   value, bool overwriteType = false);
+        void SetString    (const std::string &itemName, const std::string &value, bool isUTF8 = false, bool overwriteType = false);
+        void SetBytes     (const std::string &itemName, const std::vector<uint8_t> &value, bool isFileData = false, bool overwriteType = false);
+        void SetBytes     (const std::string &itemName, std::vector<uint8_t> &&value, bool isFileData = false, bool overwriteType = false);
+
+        // References the bytes in place, rather than copying them: they must
+        // stay alive and unchanged until the table is saved (or the item set
+        // again), and GetItem sees the item with no data.
+        void SetBytes     (const std::string &itemName, const uint8_t *data, size_t size, bool isFileData = false, bool overwriteType = false);
+
+        // Streams the file's bytes in at save time. Its size is taken now, and
+        // saving fails if the file no longer has that many bytes.
+        bool SetBytesFromFile(const std::string &itemName, const std::string &path, bool isFileData = false, bool overwriteType = false);
+
+        // Marks every BLOB item (as of now) of at least minSize bytes to be
+        // compressed when saved.
+        void SetCompression(Compression compression, size_t minSize = GALAMAKE_COMPRESSION_MIN_SIZE);
+
+        // File IO
+        bool Save(const std::string &filename);
+
+        GresTable();
+};
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <deque>
+
+// Work-stealing thread pool.
+// Jobs submitted from outside the pool go to a shared FIFO queue, so they
+// start in submission order. Jobs a worker spawns go to its own queue,
+// which it runs newest-first; idle workers steal from the other queues.
+class JobPool {
+    private:
+        struct WorkerQueue {
+            std::deque<std::function<void()>> jobs;
+            std::mutex mutex;
+        };
+
+        WorkerQueue sharedQueue;
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        std::vector<std::thread> threads;
+
+        std::mutex stateMutex;
+        std::condition_variable wakeCondition, idleCondition;
+        size_t queuedJobs = 0;
+        size_t pendingJobs = 0;
+        bool stopping = false;
+
+        bool PopJob(size_t queueIndex, std::function<void()> &job);
+        bool RunOwnJob();
+        void WorkerLoop(size_t queueIndex);
+    public:
+        void Submit(std::function<void()> job);
+        void Wait();
+
+        // Runs a batch of jobs and returns once they are done (other jobs may
+        // still be running). Safe from within a job: the calling worker runs
+        // its share of the batch itself instead of blocking a thread.
+        void RunBatch(std::vector<std::function<void()>> jobs);
+
+        size_t GetWorkerCount() const;
+
+        JobPool(size_t workerCount = 0);
+        ~JobPool();
+};
+
+size_t GetDefaultJobCount();
\ No newline at end of file
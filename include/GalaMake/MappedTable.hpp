@@ -0,0 +1,59 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+
+#include <string_view>
+#include <unordered_map>
+
+// Read-only view of an XDT file, mapped into memory.
+// Opening parses only the header and directory: item data is never copied,
+// and views into it stay valid until the table is closed.
+class MappedTable {
+    public:
+        struct ItemView {
+            std::string_view name;
+            xdt::ItemType   type;
+            xdt::ItemFlags  flags;
+            const uint8_t   *data;
+            size_t          size;
+        };
+    private:
+        const uint8_t *mapping = nullptr;
+        size_t mappingSize = 0;
+
+        std::vector<ItemView> directory;
+        std::unordered_map<std::string_view, size_t> index;
+
+        bool ParseDirectory();
+    public:
+        xdt::HeaderInfo headerInfo;
+
+        bool Open(const std::string &filename);
+        void Close();
+        bool IsOpen() const;
+
+        // General item stuff
+        const ItemView  *GetItem    (std::string_view itemName) const;
+        bool            ItemExists  (std::string_view itemName) const;
+        size_t          GetItemCount() const;
+
+        const std::vector<ItemView> &GetDirectory() const;
+
+        // Getters (like xdt::Item's, these return empty/zero values for
+        // missing items, or items of an incompatible type, which includes
+        // compressed items)
+        std::string_view    GetString   (std::string_view itemName) const;
+        int64_t             GetInteger  (std::string_view itemName) const;
+        double              GetFloat    (std::string_view itemName) const;
+
+        // Copies an item's data out, decompressing it if need be.
+        bool ReadBytes(std::string_view itemName, std::vector<uint8_t> &out) const;
+
+        MappedTable();
+        MappedTable(const MappedTable &) = delete;
+        MappedTable &operator=(const MappedTable &) = delete;
+        ~MappedTable();
+};
+
+size_t GetItemValueSize(xdt::ItemType type);
+std::string GetItemValueString(const MappedTable::ItemView &item, size_t maxLength = 48);
\ No newline at end of file
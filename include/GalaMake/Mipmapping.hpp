@@ -0,0 +1,10 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+#include <GalaMake/Trimming.hpp>
+
+// Builds the mip chain below the given (level 0) image, down to 1x1. Each
+// level is a 2x2 box filter of the one above, averaged in linear light (the
+// colour channels are treated as sRGB; alpha is linear already) and weighted
+// by alpha, so transparent texels don't darken the edges of lower levels.
+std::vector<RGBAImage> GenerateMipmaps(const RGBAImage &image);
\ No newline at end of file
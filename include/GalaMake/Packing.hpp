@@ -0,0 +1,31 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+
+#define GALAMAKE_PACK_MAGIC       "GPAK"
+#define GALAMAKE_PACK_VERSION     1
+#define GALAMAKE_PACK_ALIGNMENT   4096
+#define GALAMAKE_PACK_HEADER_SIZE 16
+#define GALAMAKE_PACK_ENTRY_SIZE  32
+
+// Pack file layout (integers are little-endian):
+//
+//   Header:        char[4] magic "GPAK", u16 version, u16 reserved,
+//                  u32 entry count, u32 string table size
+//   Index:         One entry per resource, sorted by hash (then name):
+//                  u64 hash, u64 payload offset, u64 payload size,
+//                  u32 name offset, u32 name length
+//   String table:  Resource URIs ("type:name"), not null-terminated.
+//   Payloads:      Each resource's '.gres' data, 4 KiB aligned.
+//
+// The hash is HashBytes() of the URI, so a reader can mmap the file and
+// binary search the index for a resource, confirming with the name.
+
+struct PackEntry {
+    std::string uri;
+    std::string path;
+};
+
+std::string GetPackPath(const json &buildConfig);
+
+bool WritePack(const std::string &filename, const std::vector<PackEntry> &entries);
\ No newline at end of file
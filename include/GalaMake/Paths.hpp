@@ -9,4 +9,5 @@ ResourcePathInfo GetNSlicesDirectories  (const json &buildConfig);
 ResourcePathInfo GetSoundsDirectories   (const json &buildConfig);
 ResourcePathInfo GetFontsDirectories    (const json &buildConfig);
 
+ResourcePathInfo GetResourceDirectories(const json &buildConfig, ResourceType type);
 ResourcePathInfo GenResourcePaths(const json &buildConfig, ResourceType type, const std::string &resourceName);
\ No newline at end of file
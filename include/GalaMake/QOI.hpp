@@ -0,0 +1,30 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+
+#define QOI_HEADER_SIZE  14
+#define QOI_PADDING_SIZE 8
+
+// Encoder implementations. Auto picks the fastest one the CPU supports; all
+// of them produce identical output.
+enum class QOIPath {
+    Auto,
+    Scalar,
+    SSE41,
+    AVX2
+};
+
+bool IsQOIPathSupported(QOIPath path);
+QOIPath GetBestQOIPath();
+std::string GetQOIPathString(QOIPath path);
+
+// Encodes image as QOI, entirely in memory. Output is identical to what
+// raylib's ExportImage writes to a '.qoi' file. Images which aren't 8-bit
+// RGB/RGBA are converted to RGBA first. Returns no bytes on failure.
+std::vector<uint8_t> EncodeQOI(const Image &image);
+
+// Encodes tightly packed 8-bit RGB (channels = 3) or RGBA (channels = 4) pixels.
+std::vector<uint8_t> EncodeQOI(const uint8_t *pixels, int width, int height, int channels, QOIPath path = QOIPath::Auto);
+
+// Decodes to tightly packed pixels, with as many channels as were encoded.
+bool DecodeQOI(const uint8_t *data, size_t size, std::vector<uint8_t> &pixels, int &width, int &height, int &channels);
\ No newline at end of file
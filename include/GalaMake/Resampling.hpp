@@ -0,0 +1,18 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+#include <GalaMake/Audio.hpp>
+
+#define GALAMAKE_RESAMPLE_ZERO_CROSSINGS 16     // Each side of the filter, at the lower of the two rates.
+#define GALAMAKE_RESAMPLE_CUTOFF         0.95   // Of the lower Nyquist frequency.
+#define GALAMAKE_RESAMPLE_KAISER_BETA    9.0
+
+// Mono is mixed down by averaging every channel, stereo is mixed up by
+// duplicating a mono channel (or down by keeping the front pair).
+AudioSamples MixAudioChannels(const AudioSamples &audio, unsigned int channels);
+
+// Converts between any two rates with a polyphase Kaiser-windowed sinc filter:
+// the rates' ratio is reduced to up/down, and each output sample is one dot
+// product with the phase of the filter it falls on. Downsampling low-passes
+// below the new Nyquist frequency first.
+AudioSamples ResampleAudio(const AudioSamples &audio, unsigned int sampleRate);
\ No newline at end of file
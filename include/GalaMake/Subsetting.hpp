@@ -0,0 +1,13 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+
+// Rewrites a TrueType font to hold only what's needed to draw the given
+// codepoints: their glyphs, the components of composite ones and '.notdef'.
+// Glyph indices are kept as they are (other glyphs are just left empty), so
+// glyph-indexed tables like 'hmtx', 'kern' and 'GPOS' stay valid untouched.
+// 'cmap' is rebuilt for the kept codepoints, 'post' loses its glyph names and
+// tables nothing reads at runtime (substitutions, embedded bitmaps, colour
+// glyphs, signatures...) are dropped. Fails for fonts without TrueType
+// outlines ('glyf'), e.g. CFF-based OpenType fonts.
+bool SubsetFont(const std::vector<uint8_t> &fontData, const std::vector<int> &codepoints, std::vector<uint8_t> &subset);
\ No newline at end of file
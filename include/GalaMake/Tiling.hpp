@@ -0,0 +1,10 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+#include <GalaMake/Trimming.hpp>
+
+// Compacts a tileset so each distinct tile_size x tile_size cell appears once,
+// keeping the tileset's width (in tiles). 'remap' gets, for every cell of the
+// original (row-major), the index of its tile in the compacted texture. Cells
+// past the last whole row or column are dropped, as no tile index reaches them.
+RGBAImage DeduplicateTiles(const RGBAImage &image, int tileSize, std::vector<uint16_t> &remap);
\ No newline at end of file
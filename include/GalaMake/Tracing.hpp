@@ -0,0 +1,56 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <atomic>
+
+// Collects timed spans, and saves them in Chrome's trace-event JSON format
+// (viewable in chrome://tracing or Perfetto). Does nothing until enabled.
+class Tracer {
+    private:
+        struct Event {
+            std::string name;
+            std::string category;
+            std::string resource;
+            std::chrono::steady_clock::time_point start, end;
+            uint32_t threadId;
+        };
+
+        std::vector<Event> events;
+        std::map<std::thread::id, uint32_t> threadIds;
+        std::mutex mutex;
+        std::chrono::steady_clock::time_point origin;
+        std::atomic<bool> enabled;
+    public:
+        void Enable();
+        bool IsEnabled() const;
+
+        void Record(
+            const std::string &name, const std::string &category, const std::string &resource,
+            std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end
+        );
+
+        bool Save(const std::string &filename);
+
+        Tracer();
+};
+
+Tracer &GetTracer();
+
+// Records a span from construction to destruction.
+// Spans in the "resource" category tag every span nested in them (on the
+// same thread) with their name.
+class TraceSpan {
+    private:
+        std::string name;
+        std::string category;
+        std::string parentResource;
+        std::chrono::steady_clock::time_point start;
+        bool active;
+    public:
+        TraceSpan(const std::string &name, const std::string &category = "stage");
+        ~TraceSpan();
+};
\ No newline at end of file
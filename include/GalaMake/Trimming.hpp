@@ -0,0 +1,34 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+
+#define GALAMAKE_TRIM_PADDING 1 // Empty pixels kept between trimmed frames.
+
+// Tightly packed 8-bit RGBA pixels.
+struct RGBAImage {
+    std::vector<uint8_t> pixels;
+    int width = 0;
+    int height = 0;
+};
+
+// A sprite frame's rectangle in its texture. Trimmed frames also record where
+// they sit within the untrimmed frame, so 'origin' keeps its meaning.
+struct SpriteFrame {
+    int x, y, width, height;
+    int offsetX = 0, offsetY = 0;
+    int sourceWidth = 0, sourceHeight = 0;
+};
+
+bool LoadRGBAImage(const std::string &path, RGBAImage &image);
+
+std::vector<SpriteFrame> GetSpriteFrames(const json &spriteConfig);
+
+// Smallest rectangle within the given one holding every pixel with non-zero
+// alpha, relative to the given one. Returns false if it is fully transparent.
+bool GetOpaqueBounds(const RGBAImage &image, int x, int y, int width, int height, SpriteFrame &bounds);
+
+// Crops every frame to its opaque bounds and repacks them into a new, smaller
+// texture. Frames are updated to point into it (fully transparent frames end
+// up empty); identical frames share their pixels. Returns an empty image if
+// the frames can't be repacked.
+RGBAImage TrimSpriteFrames(const RGBAImage &image, std::vector<SpriteFrame> &frames);
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+
+#include <set>
+
+// Minimal reader for TrueType/OpenType font files: the table directory,
+// character mapping ('cmap' formats 4 and 12), vertical metrics ('hhea') and
+// horizontal kerning (GPOS 'kern' feature pair adjustments, falling back to
+// the old 'kern' table). Everything is bounds-checked; tables which are
+// missing or malformed read as empty.
+class TrueTypeFont {
+    public:
+        struct Table {
+            uint32_t tag;
+            uint32_t offset;
+            uint32_t length;
+        };
+    private:
+        const uint8_t *data = nullptr;
+        size_t size = 0;
+
+        std::vector<Table> tables;
+
+        // Best Unicode subtable in 'cmap' (absolute offset and format), or 0.
+        uint32_t cmapOffset = 0;
+        uint16_t cmapFormat = 0;
+
+        std::vector<std::vector<uint32_t>> kernLookups; // GPOS pair adjustment subtables (absolute offsets), by lookup.
+
+        bool Has(size_t offset, size_t count) const;
+        uint16_t U16(size_t offset) const;
+        uint32_t U32(size_t offset) const;
+
+        void FindCMap();
+        void FindKernLookups();
+
+        int GetCoverageIndex(uint32_t coverageOffset, int glyph) const;
+        std::vector<std::pair<int, int>> GetCoveredGlyphs(uint32_t coverageOffset, const std::vector<bool> &wanted) const;
+        int GetGlyphClass(uint32_t classDefOffset, int glyph) const;
+        bool GetPairAdjustment(uint32_t subtableOffset, int first, int second, int &adjustment) const;
+        int GetKernTableKerning(int first, int second) const;
+        void AddPairAdjustments(uint32_t subtableOffset, const std::vector<int> &glyphs, const std::vector<bool> &wanted,
+            std::set<int> &claimedFirsts, std::set<uint32_t> &claimedPairs, std::map<uint32_t, int> &pairs) const;
+        void AddKernTablePairs(const std::vector<bool> &wanted, std::map<uint32_t, int> &pairs) const;
+    public:
+        // The data must outlive the font.
+        bool Open(const uint8_t *data, size_t size);
+
+        const std::vector<Table> &GetTables() const;
+        const Table *GetTable(const char *tag) const;
+
+        int GetGlyphIndex(int codepoint) const; // 0 (.notdef) if unmapped.
+        int GetGlyphCount() const;              // From 'maxp'.
+
+        // Horizontal adjustment between two glyphs, in font units.
+        int GetKerning(int firstGlyph, int secondGlyph) const;
+        bool HasKerning() const;
+
+        // Non-zero kerning between any two of the given glyphs, in font units,
+        // keyed by (first << 16) | second. Walks the pair tables once, so it
+        // costs about as much as the font has pairs, not the square of the glyphs.
+        std::map<uint32_t, int> GetKerningPairs(const std::vector<int> &glyphs) const;
+
+        // Font units to pixels, as used by raylib (ascent to descent = pixelHeight).
+        float GetScaleForPixelHeight(float pixelHeight) const;
+};
+
+uint32_t GetTrueTypeTag(const char *tag);
\ No newline at end of file
@@ -1,9 +1,13 @@
 #pragma once
 
 #include <GalaMake/Common.hpp>
+
+#include <chrono>
+
+// Wall-clock (monotonic) timer.
 class Timer {
     private:
-        clock_t clock_start, clock_end;
+        std::chrono::steady_clock::time_point clock_start, clock_end;
     public:
         void Start();
         double Stop();
@@ -11,6 +15,28 @@ class Timer {
         Timer();
 };
 
+// Hashing
+class Hasher {
+    private:
+        uint64_t state;
+        uint64_t length;
+        uint8_t tail[8];
+        size_t tailSize;
+
+        void Mix(uint64_t word);
+    public:
+        void Update(const void *data, size_t size);
+        uint64_t Finish() const;
+
+        Hasher(uint64_t seed = 0);
+};
+
+uint64_t HashBytes(const void *data, size_t size, uint64_t seed = 0);
+bool HashFile(const std::string &path, uint64_t &hash);
+
+// Etc..
 std::vector<std::string> ScanResources(const json &buildConfig, bool jsonCheck = true);
 
-std::pair<std::string, std::string> SplitResourceURI(const std::string &uri);
\ No newline at end of file
+std::pair<std::string, std::string> SplitResourceURI(const std::string &uri);
+
+std::string GetResourceTypeString(ResourceType type);
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+
+#include <set>
+
+#define GALAMAKE_WATCH_DEBOUNCE_MS 250
+
+// Watches the workspace (each asset directory, and each resource directory
+// within them) for changes to resources. Linux only (inotify).
+class WorkspaceWatcher {
+    private:
+        struct WatchTarget {
+            ResourceType type;
+            std::string resourceName; // Empty for an asset directory.
+        };
+
+        int fd = -1;
+        json buildConfig;
+        std::map<int, WatchTarget> targets;
+        std::map<int, std::string> targetPaths;
+        std::set<std::string> watchedPaths;
+
+        void AddWatch(const std::string &path, const WatchTarget &target);
+        void AddAssetDirectory(ResourceType type);
+        bool ReadEvents(std::set<std::string> &changed);
+    public:
+        bool Start(const json &buildConfig);
+
+        // Blocks until resources change, then until no more changes arrive for
+        // debounceMs; returns the URIs ("type:name") of changed resources.
+        std::vector<std::string> WaitForChanges(int debounceMs = GALAMAKE_WATCH_DEBOUNCE_MS);
+
+        WorkspaceWatcher();
+        ~WorkspaceWatcher();
+};
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <GalaMake/Common.hpp>
+
+#include <sys/uio.h>
+
+#define GALAMAKE_WRITE_GATHER_SIZE (256 * 1024) // Writes this large bypass gathering.
+#define GALAMAKE_WRITE_COPY_SIZE   (1 << 20)    // Buffer size when copying files by hand.
+
+// Unbuffered writer over a file descriptor.
+// Small writes are gathered (by pointer, not copied) and flushed together with
+// writev, so the memory passed to Write must stay alive until the next Flush
+// or Close. Large writes, and whole files, go straight to the file.
+class FileWriter {
+    private:
+        int fd = -1;
+        bool failed = false;
+
+        std::vector<struct iovec> pending;
+        size_t pendingBytes = 0;
+
+        bool WriteAll(const uint8_t *data, size_t size);
+        bool CopyFrom(int inFd, size_t size);
+    public:
+        bool Open(const std::string &filename);
+
+        void Write(const void *data, size_t size);
+        void WriteFile(const std::string &path, size_t size); // Exactly size bytes, or fails.
+
+        bool Flush();
+        bool Close();
+
+        FileWriter();
+        ~FileWriter();
+};
+
+// Copies a file, sharing its blocks with the original (a reflink) where the
+// filesystem supports it, or copying them otherwise.
+bool CloneFile(const std::string &from, const std::string &to);
\ No newline at end of file
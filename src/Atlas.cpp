@@ -0,0 +1,303 @@
+#include <GalaMake/Atlas.hpp>
+#include <GalaMake/GresTable.hpp>
+#include <GalaMake/QOI.hpp>
+#include <GalaMake/Tracing.hpp>
+#include <GalaMake/Utils.hpp>
+
+#include <cstring>
+
+// Packer
+MaxRectsPacker::MaxRectsPacker(int width, int height) : binWidth(width), binHeight(height) {
+    freeRects.push_back({0, 0, width, height});
+}
+
+bool MaxRectsPacker::Insert(int width, int height, int &x, int &y) {
+    // Best short side fit: the free rect leaving the least room on its tighter side.
+    const Rect *best = nullptr;
+    int bestShort = INT32_MAX, bestLong = INT32_MAX;
+
+    for(auto &r : freeRects) {
+        if((width > r.width) || (height > r.height)) continue;
+
+        const int leftX = r.width - width, leftY = r.height - height;
+        const int shortSide = std::min(leftX, leftY), longSide = std::max(leftX, leftY);
+
+        if((shortSide < bestShort) || ((shortSide == bestShort) && (longSide < bestLong))) {
+            best = &r;
+            bestShort = shortSide;
+            bestLong = longSide;
+        }
+    }
+
+    if(!best) return false;
+
+    const Rect used = {best->x, best->y, width, height};
+    x = used.x;
+    y = used.y;
+
+    SplitFreeRects(used);
+    PruneFreeRects();
+
+    usedWidth  = std::max(usedWidth, used.x + used.width);
+    usedHeight = std::max(usedHeight, used.y + used.height);
+
+    return true;
+}
+
+void MaxRectsPacker::SplitFreeRects(const Rect &used) {
+    std::vector<Rect> out;
+
+    for(auto &r : freeRects) {
+        const bool overlaps =
+            (used.x < r.x + r.width) && (used.x + used.width > r.x) &&
+            (used.y < r.y + r.height) && (used.y + used.height > r.y);
+
+        if(!overlaps) { out.push_back(r); continue; }
+
+        // Keep whatever of r lies to each side of the used rect.
+        if(used.x > r.x)
+            out.push_back({r.x, r.y, used.x - r.x, r.height});
+        if(used.x + used.width < r.x + r.width)
+            out.push_back({used.x + used.width, r.y, r.x + r.width - (used.x + used.width), r.height});
+        if(used.y > r.y)
+            out.push_back({r.x, r.y, r.width, used.y - r.y});
+        if(used.y + used.height < r.y + r.height)
+            out.push_back({r.x, used.y + used.height, r.width, r.y + r.height - (used.y + used.height)});
+    }
+
+    freeRects = std::move(out);
+}
+
+void MaxRectsPacker::PruneFreeRects() {
+    auto contains = [](const Rect &a, const Rect &b) {
+        return (b.x >= a.x) && (b.y >= a.y) &&
+            (b.x + b.width <= a.x + a.width) && (b.y + b.height <= a.y + a.height);
+    };
+
+    std::vector<bool> redundant(freeRects.size(), false);
+
+    for(size_t i = 0; i < freeRects.size(); i++) {
+        if(redundant[i]) continue;
+
+        for(size_t j = 0; j < freeRects.size(); j++) {
+            if((i == j) || redundant[j]) continue;
+
+            if(contains(freeRects[j], freeRects[i])) { redundant[i] = true; break; }
+        }
+    }
+
+    std::vector<Rect> out;
+    for(size_t i = 0; i < freeRects.size(); i++)
+        if(!redundant[i]) out.push_back(freeRects[i]);
+
+    freeRects = std::move(out);
+}
+
+void MaxRectsPacker::GetUsedSize(int &width, int &height) const {
+    width = usedWidth;
+    height = usedHeight;
+}
+
+// Pages
+std::string GetAtlasDirectory(const json &buildConfig) {
+    return (buildConfig["build_options"]["output_dir"]).get<std::string>() + GALAMAKE_ATLAS_DIR;
+}
+
+std::string GetAtlasPagePath(const json &buildConfig, const std::string &page) {
+    return GetAtlasDirectory(buildConfig) + page + ".gres";
+}
+
+std::vector<std::string> ScanAtlasPages(const json &buildConfig) {
+    std::vector<std::string> out;
+
+    const std::string dir = GetAtlasDirectory(buildConfig);
+    if(!(std::filesystem::exists(dir) && std::filesystem::is_directory(dir)))
+        return out;
+
+    for(auto &p : std::filesystem::directory_iterator(dir)) {
+        if(!p.is_regular_file() || (p.path().extension() != ".gres")) continue;
+
+        out.push_back(p.path().stem().string());
+    }
+
+    std::sort(out.begin(), out.end());
+
+    return out;
+}
+
+void ClearAtlasPages(const json &buildConfig) {
+    for(auto &page : ScanAtlasPages(buildConfig)) {
+        std::error_code ec;
+        std::filesystem::remove(GetAtlasPagePath(buildConfig, page), ec);
+    }
+}
+
+static int NextPowerOfTwo(int value) {
+    int out = 1;
+    while(out < value) out <<= 1;
+
+    return out;
+}
+
+struct AtlasImage {
+    std::string uri;
+    std::string filter;
+    RGBAImage image;
+    std::vector<SpriteFrame> frames;
+};
+
+bool BuildAtlases(
+    const json &buildConfig,
+    const std::vector<ValidatedResource> &resources,
+    int maxSize,
+    JobPool &pool,
+    std::map<std::string, AtlasPlacement> &placements
+) {
+    TraceSpan atlasSpan("atlas");
+
+    ClearAtlasPages(buildConfig);
+
+    // Load every texture
+    std::vector<AtlasImage> images(resources.size());
+    std::vector<char> loaded(resources.size(), false);
+
+    {
+        TraceSpan span("decode");
+
+        for(size_t i = 0; i < resources.size(); i++) {
+            pool.Submit([&, i] {
+                const ValidatedResource &resource = resources[i];
+                if(resource.contentPaths.count("texture") == 0) return;
+
+                AtlasImage &image = images[i];
+                image.uri = GetResourceTypeString(resource.info.type) + ":" + resource.info.name;
+
+                if(resource.config.contains("texture_filter"))
+                    image.filter = resource.config["texture_filter"].get<std::string>();
+
+                if(!LoadRGBAImage(resource.contentPaths.at("texture"), image.image)) return;
+
+                if((resource.info.type == ResourceType::Sprite) && resource.config.value("trim", false)) {
+                    image.frames = GetSpriteFrames(resource.config);
+                    image.image = TrimSpriteFrames(image.image, image.frames);
+                    if(image.image.pixels.empty()) return;
+                }
+
+                loaded[i] = true;
+            });
+        }
+
+        pool.Wait();
+    }
+
+    for(size_t i = 0; i < resources.size(); i++)
+        if(resources[i].contentPaths.count("texture") && !loaded[i]) return false;
+
+    // Group by filter (pages can only have one), largest images first.
+    std::map<std::string, std::vector<const AtlasImage *>> groups;
+
+    for(size_t i = 0; i < images.size(); i++) {
+        if(!loaded[i]) continue;
+
+        const AtlasImage &image = images[i];
+        if((image.image.width + GALAMAKE_ATLAS_PADDING > maxSize) || (image.image.height + GALAMAKE_ATLAS_PADDING > maxSize))
+            continue; // Too large to share a page; builds standalone.
+
+        groups[image.filter].push_back(&image);
+    }
+
+    // Pack
+    struct Page {
+        std::string filter;
+        MaxRectsPacker packer;
+        std::vector<std::pair<const AtlasImage *, AtlasPlacement>> entries;
+    };
+
+    std::vector<Page> pages;
+
+    for(auto &[filter, group] : groups) {
+        std::sort(group.begin(), group.end(), [](const AtlasImage *a, const AtlasImage *b) {
+            const int sideA = std::max(a->image.width, a->image.height), sideB = std::max(b->image.width, b->image.height);
+            const int areaA = a->image.width * a->image.height, areaB = b->image.width * b->image.height;
+
+            if(sideA != sideB) return sideA > sideB;
+            if(areaA != areaB) return areaA > areaB;
+            return a->uri < b->uri;
+        });
+
+        const size_t firstPage = pages.size();
+
+        for(auto image : group) {
+            const int w = image->image.width + GALAMAKE_ATLAS_PADDING, h = image->image.height + GALAMAKE_ATLAS_PADDING;
+
+            int x = 0, y = 0;
+            size_t p = firstPage;
+
+            for(; p < pages.size(); p++)
+                if(pages[p].packer.Insert(w, h, x, y)) break;
+
+            if(p == pages.size()) {
+                pages.push_back({filter, MaxRectsPacker(maxSize, maxSize), {}});
+                pages.back().packer.Insert(w, h, x, y);
+            }
+
+            pages[p].entries.push_back({image, {"page_" + std::to_string(p), x, y, image->image.width, image->image.height, image->frames}});
+        }
+    }
+
+    // Compose and write each page
+    std::filesystem::create_directories(GetAtlasDirectory(buildConfig));
+
+    std::vector<char> written(pages.size(), false);
+
+    {
+        TraceSpan span("pages");
+
+        for(size_t p = 0; p < pages.size(); p++) {
+            pool.Submit([&, p] {
+                const Page &page = pages[p];
+
+                int usedWidth = 0, usedHeight = 0;
+                page.packer.GetUsedSize(usedWidth, usedHeight);
+
+                const int width = NextPowerOfTwo(usedWidth), height = NextPowerOfTwo(usedHeight);
+                std::vector<uint8_t> pixels((size_t)width * height * 4, 0x00);
+
+                for(auto &[image, placement] : page.entries) {
+                    for(int row = 0; row < placement.height; row++) {
+                        memcpy(
+                            pixels.data() + ((size_t)(placement.y + row) * width + placement.x) * 4,
+                            image->image.pixels.data() + (size_t)row * placement.width * 4,
+                            (size_t)placement.width * 4
+                        );
+                    }
+                }
+
+                std::vector<uint8_t> textureData = EncodeQOI(pixels.data(), width, height, 4);
+                if(textureData.empty()) return;
+
+                GresTable gresTable;
+
+                gresTable.SetString("type", "atlas");
+
+                if(!page.filter.empty())
+                    gresTable.SetString("texture_filter", page.filter);
+
+                gresTable.SetBytes("texture", std::move(textureData));
+
+                written[p] = gresTable.Save(GetAtlasPagePath(buildConfig, "page_" + std::to_string(p)));
+            });
+        }
+
+        pool.Wait();
+    }
+
+    for(size_t p = 0; p < pages.size(); p++) {
+        if(!written[p]) return false;
+
+        for(auto &[image, placement] : pages[p].entries)
+            placements[image->uri] = placement;
+    }
+
+    return true;
+}
\ No newline at end of file
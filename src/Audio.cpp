@@ -0,0 +1,459 @@
+#include <GalaMake/Audio.hpp>
+
+#include <cmath>
+#include <cstring>
+
+static inline uint16_t ReadLE16(const uint8_t *p) {
+    return p[0] | (p[1] << 8);
+}
+
+static inline uint32_t ReadLE32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint64_t ReadLE64(const uint8_t *p) {
+    return ReadLE32(p) | ((uint64_t)ReadLE32(p + 4) << 32);
+}
+
+// Wave
+#define WAVE_FORMAT_PCM         0x0001
+#define WAVE_FORMAT_ADPCM       0x0002
+#define WAVE_FORMAT_IEEE_FLOAT  0x0003
+#define WAVE_FORMAT_ALAW        0x0006
+#define WAVE_FORMAT_MULAW       0x0007
+#define WAVE_FORMAT_DVI_ADPCM   0x0011
+#define WAVE_FORMAT_EXTENSIBLE  0xFFFE
+
+bool ProbeWaveFile(const std::string &path, AudioInfo &info) {
+    std::ifstream f(path, std::ios::binary);
+    if(!f.good()) return false;
+
+    f.seekg(0, std::ios::end);
+    const uint64_t fileSize = f.tellg();
+    f.seekg(0, std::ios::beg);
+
+    uint8_t riff[12];
+    if(!f.read((char *)riff, sizeof(riff))) return false;
+    if(std::memcmp(riff + 0, "RIFF", 4) != 0) return false;
+    if(std::memcmp(riff + 8, "WAVE", 4) != 0) return false;
+
+    uint16_t format = 0, blockAlign = 0;
+    uint32_t factFrames = 0;
+    uint64_t dataSize = 0;
+    bool hasFormat = false, hasData = false;
+
+    // Walk chunks, skipping over their contents.
+    uint64_t position = sizeof(riff);
+
+    while(!hasData && (position + 8 <= fileSize)) {
+        uint8_t header[8];
+        f.seekg(position);
+        if(!f.read((char *)header, sizeof(header))) return false;
+
+        const uint32_t chunkSize = ReadLE32(header + 4);
+        const uint64_t chunkStart = position + sizeof(header);
+
+        if(std::memcmp(header, "fmt ", 4) == 0) {
+            uint8_t fmt[40] = {};
+            if(chunkSize < 16) return false;
+            if(!f.read((char *)fmt, std::min<uint32_t>(chunkSize, sizeof(fmt)))) return false;
+
+            format          = ReadLE16(fmt + 0);
+            info.channels   = ReadLE16(fmt + 2);
+            info.sampleRate = ReadLE32(fmt + 4);
+            blockAlign      = ReadLE16(fmt + 12);
+            info.sampleSize = ReadLE16(fmt + 14);
+
+            // Extensible: the real format is the first two bytes of the sub-format GUID.
+            if((format == WAVE_FORMAT_EXTENSIBLE) && (chunkSize >= 26))
+                format = ReadLE16(fmt + 24);
+
+            hasFormat = true;
+        }else if(std::memcmp(header, "fact", 4) == 0) {
+            uint8_t fact[4];
+            if(chunkSize >= 4 && f.read((char *)fact, sizeof(fact)))
+                factFrames = ReadLE32(fact);
+        }else if(std::memcmp(header, "data", 4) == 0) {
+            // Some writers leave the size unset when streaming; trust the file.
+            dataSize = std::min<uint64_t>(chunkSize, fileSize - chunkStart);
+            hasData = true;
+        }
+
+        position = chunkStart + chunkSize + (chunkSize & 1);
+    }
+
+    if(!(hasFormat && hasData)) return false;
+    if((info.channels == 0) || (info.sampleRate == 0) || (blockAlign == 0)) return false;
+
+    switch(format) {
+        case WAVE_FORMAT_PCM:
+        case WAVE_FORMAT_IEEE_FLOAT:
+        case WAVE_FORMAT_ALAW:
+        case WAVE_FORMAT_MULAW:
+            if(info.sampleSize == 0) return false;
+            info.frameCount = dataSize / blockAlign;
+            break;
+        case WAVE_FORMAT_ADPCM:
+        case WAVE_FORMAT_DVI_ADPCM:
+            info.sampleSize = 16;
+            info.frameCount = factFrames;
+            break;
+        default:
+            return false;
+    }
+
+    return info.frameCount > 0;
+}
+
+// Ogg Vorbis
+#define OGG_PAGE_HEADER_SIZE 27
+#define OGG_PAGE_MAX_SIZE    (OGG_PAGE_HEADER_SIZE + 255 + 255 * 255)
+#define OGG_HEADER_BOS       0x02
+
+// Pass the previous result as 'crc' to continue over more bytes.
+static uint32_t OggCRC(const uint8_t *data, size_t size, uint32_t crc = 0) {
+    static uint32_t table[256];
+    static const bool tableReady = [] {
+        for(uint32_t i = 0; i < 256; i++) {
+            uint32_t r = i << 24;
+            for(int b = 0; b < 8; b++)
+                r = (r & 0x80000000) ? ((r << 1) ^ 0x04C11DB7) : (r << 1);
+            table[i] = r;
+        }
+        return true;
+    }();
+    (void)tableReady;
+
+    for(size_t i = 0; i < size; i++)
+        crc = (crc << 8) ^ table[((crc >> 24) ^ data[i]) & 0xFF];
+
+    return crc;
+}
+
+// Checks a whole page at 'page' (with 'available' bytes readable) and returns its size, or 0.
+static size_t CheckOggPage(const uint8_t *page, size_t available) {
+    if(available < OGG_PAGE_HEADER_SIZE) return 0;
+    if(std::memcmp(page, "OggS", 4) != 0) return 0;
+    if(page[4] != 0) return 0; // Stream structure version
+
+    const size_t segments = page[26];
+    if(available < OGG_PAGE_HEADER_SIZE + segments) return 0;
+
+    size_t pageSize = OGG_PAGE_HEADER_SIZE + segments;
+    for(size_t i = 0; i < segments; i++)
+        pageSize += page[OGG_PAGE_HEADER_SIZE + i];
+
+    if(available < pageSize) return 0;
+
+    // CRC is computed with its own field zeroed.
+    static const uint8_t zeroes[4] = {0, 0, 0, 0};
+
+    uint32_t crc = OggCRC(page, 22);
+    crc = OggCRC(zeroes, 4, crc);
+    crc = OggCRC(page + 26, pageSize - 26, crc);
+    if(crc != ReadLE32(page + 22)) return 0;
+
+    return pageSize;
+}
+
+bool ProbeVorbisFile(const std::string &path, AudioInfo &info) {
+    std::ifstream f(path, std::ios::binary);
+    if(!f.good()) return false;
+
+    f.seekg(0, std::ios::end);
+    const uint64_t fileSize = f.tellg();
+    f.seekg(0, std::ios::beg);
+
+    // First page: must start the stream and hold the identification header.
+    std::vector<uint8_t> buffer(std::min<uint64_t>(fileSize, OGG_PAGE_MAX_SIZE));
+    if(!f.read((char *)buffer.data(), buffer.size())) return false;
+
+    const size_t firstPageSize = CheckOggPage(buffer.data(), buffer.size());
+    if(firstPageSize == 0) return false;
+    if(!(buffer[5] & OGG_HEADER_BOS)) return false;
+
+    const uint32_t serial = ReadLE32(buffer.data() + 14);
+    const uint8_t *packet = buffer.data() + OGG_PAGE_HEADER_SIZE + buffer[26];
+
+    if(firstPageSize - (packet - buffer.data()) < 30) return false;
+    if((packet[0] != 0x01) || (std::memcmp(packet + 1, "vorbis", 6) != 0)) return false;
+    if(ReadLE32(packet + 7) != 0) return false;     // Vorbis version
+    if((packet[29] & 0x01) == 0) return false;      // Framing bit
+
+    info.channels   = packet[11];
+    info.sampleRate = ReadLE32(packet + 12);
+    info.sampleSize = 16;
+
+    if((info.channels == 0) || (info.sampleRate == 0)) return false;
+
+    // Last page of this stream: its granule position is the total frame count.
+    const uint64_t tailSize = std::min<uint64_t>(fileSize, 2 * OGG_PAGE_MAX_SIZE);
+    std::vector<uint8_t> tail(tailSize);
+    f.seekg(fileSize - tailSize);
+    if(!f.read((char *)tail.data(), tail.size())) return false;
+
+    info.frameCount = 0;
+
+    for(size_t i = tailSize - OGG_PAGE_HEADER_SIZE + 1; i-- > 0;) {
+        if(std::memcmp(tail.data() + i, "OggS", 4) != 0) continue;
+        if(ReadLE32(tail.data() + i + 14) != serial) continue;
+        if(CheckOggPage(tail.data() + i, tailSize - i) == 0) continue;
+
+        const uint64_t granule = ReadLE64(tail.data() + i + 6);
+        if(granule == UINT64_MAX) continue; // No packet ends on this page.
+
+        info.frameCount = granule;
+        break;
+    }
+
+    return info.frameCount > 0;
+}
+
+bool ProbeAudioFile(const std::string &path, AudioInfo &info) {
+    const std::string ext = std::filesystem::path(path).extension().string();
+
+    if(ext == ".wav") return ProbeWaveFile(path, info);
+    if(ext == ".ogg") return ProbeVorbisFile(path, info);
+
+    return false;
+}
+
+bool DecodeAudioFile(const std::string &path, AudioInfo &info) {
+    Wave wav_audio = LoadWave(path.c_str());
+
+    info.channels   = wav_audio.channels;
+    info.sampleRate = wav_audio.sampleRate;
+    info.sampleSize = wav_audio.sampleSize;
+    info.frameCount = wav_audio.frameCount;
+
+    const bool success =
+        (wav_audio.data != NULL) &&
+        (info.channels > 0) &&
+        (info.sampleRate > 0) &&
+        (info.sampleSize > 0) &&
+        (info.frameCount > 0);
+
+    UnloadWave(wav_audio);
+
+    return success;
+}
+
+// Samples
+bool LoadAudioSamples(const std::string &path, AudioSamples &audio) {
+    Wave wave = LoadWave(path.c_str());
+    if(!wave.data) return false;
+
+    float *samples = LoadWaveSamples(wave);
+    const bool success = (samples != NULL) && (wave.channels > 0) && (wave.sampleRate > 0) && (wave.frameCount > 0);
+
+    if(success) {
+        audio.channels   = wave.channels;
+        audio.sampleRate = wave.sampleRate;
+        audio.frameCount = wave.frameCount;
+        audio.samples.assign(samples, samples + (size_t)wave.frameCount * wave.channels);
+    }
+
+    if(samples) UnloadWaveSamples(samples);
+    UnloadWave(wave);
+
+    return success;
+}
+
+// Encoding
+static std::map<std::string, WaveEncoding> s_waveEncodingStrs = {
+    {"pcm8",  WaveEncoding::PCM8},
+    {"pcm16", WaveEncoding::PCM16},
+    {"adpcm", WaveEncoding::IMAADPCM}
+};
+
+bool GetWaveEncodingFromString(const std::string &str, WaveEncoding &encoding) {
+    if(s_waveEncodingStrs.count(str) == 0) return false;
+
+    encoding = s_waveEncodingStrs[str];
+    return true;
+}
+
+std::string GetWaveEncodingString(WaveEncoding encoding) {
+    for(auto &[str, e] : s_waveEncodingStrs)
+        if(e == encoding) return str;
+
+    return "pcm16";
+}
+
+static inline void WriteLE16(std::vector<uint8_t> &out, uint16_t value) {
+    out.push_back(value & 0xFF);
+    out.push_back(value >> 8);
+}
+
+static inline void WriteLE32(std::vector<uint8_t> &out, uint32_t value) {
+    WriteLE16(out, value & 0xFFFF);
+    WriteLE16(out, value >> 16);
+}
+
+static inline int16_t ToInt16(float sample) {
+    return (int16_t)std::lrint(std::min(std::max(sample, -1.0f), 1.0f) * 32767.0f);
+}
+
+// IMA ADPCM
+static const int16_t s_imaSteps[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+    11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+    32767
+};
+
+static const int s_imaIndexSteps[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+struct IMAState {
+    int predictor = 0;
+    int index = 0;
+};
+
+// Picks the nibble the decoder will step closest with, and steps with it too.
+static uint8_t EncodeIMASample(IMAState &state, int sample) {
+    int step = s_imaSteps[state.index];
+    int diff = sample - state.predictor;
+    uint8_t nibble = 0;
+
+    if(diff < 0) { nibble = 8; diff = -diff; }
+
+    int delta = step >> 3;
+    if(diff >= step) { nibble |= 4; diff -= step; delta += step; }
+    step >>= 1;
+    if(diff >= step) { nibble |= 2; diff -= step; delta += step; }
+    step >>= 1;
+    if(diff >= step) { nibble |= 1; delta += step; }
+
+    state.predictor += (nibble & 8) ? -delta : delta;
+    state.predictor = std::min(std::max(state.predictor, -32768), 32767);
+    state.index = std::min(std::max(state.index + s_imaIndexSteps[nibble & 7], 0), 88);
+
+    return nibble;
+}
+
+// Each block starts with a header per channel (first sample and step index),
+// then alternates 4 bytes (8 samples) per channel, low nibbles first.
+static void EncodeIMABlocks(const AudioSamples &audio, uint32_t framesPerBlock, std::vector<uint8_t> &out) {
+    const unsigned int channels = audio.channels;
+    std::vector<IMAState> states(channels);
+
+    auto sampleAt = [&](uint64_t frame, unsigned int channel) -> int {
+        return (frame < audio.frameCount) ? ToInt16(audio.samples[frame * channels + channel]) : 0;
+    };
+
+    for(uint64_t blockStart = 0; blockStart < audio.frameCount; blockStart += framesPerBlock) {
+        for(unsigned int c = 0; c < channels; c++) {
+            states[c].predictor = sampleAt(blockStart, c);
+
+            WriteLE16(out, (uint16_t)(int16_t)states[c].predictor);
+            out.push_back(states[c].index);
+            out.push_back(0);
+        }
+
+        for(uint32_t group = 1; group < framesPerBlock; group += 8) {
+            for(unsigned int c = 0; c < channels; c++) {
+                for(uint32_t i = 0; i < 8; i += 2) {
+                    const uint8_t low = EncodeIMASample(states[c], sampleAt(blockStart + group + i, c));
+                    const uint8_t high = EncodeIMASample(states[c], sampleAt(blockStart + group + i + 1, c));
+
+                    out.push_back(low | (high << 4));
+                }
+            }
+        }
+    }
+}
+
+std::vector<uint8_t> GetPCMBytes(const AudioSamples &audio, unsigned int sampleSize) {
+    const size_t sampleCount = (size_t)audio.frameCount * audio.channels;
+    std::vector<uint8_t> out;
+
+    if(sampleSize == 8) {
+        out.resize(sampleCount);
+        for(size_t i = 0; i < sampleCount; i++)
+            out[i] = (uint8_t)(std::lrint(std::min(std::max(audio.samples[i], -1.0f), 1.0f) * 127.0f) + 128);
+    }else {
+        out.reserve(sampleCount * 2);
+        for(size_t i = 0; i < sampleCount; i++)
+            WriteLE16(out, (uint16_t)ToInt16(audio.samples[i]));
+    }
+
+    return out;
+}
+
+std::vector<uint8_t> EncodeWave(const AudioSamples &audio, WaveEncoding encoding) {
+    const unsigned int channels = audio.channels;
+
+    uint16_t format = WAVE_FORMAT_PCM, bitsPerSample = 16, blockAlign = 2 * channels;
+    uint32_t framesPerBlock = 1;
+
+    switch(encoding) {
+        case WaveEncoding::PCM8:
+            bitsPerSample = 8;
+            blockAlign = channels;
+            break;
+        case WaveEncoding::PCM16:
+            break;
+        case WaveEncoding::IMAADPCM:
+            format = WAVE_FORMAT_DVI_ADPCM;
+            bitsPerSample = 4;
+            blockAlign = GALAMAKE_ADPCM_BLOCK_SIZE * channels;
+            framesPerBlock = (GALAMAKE_ADPCM_BLOCK_SIZE - 4) * 2 + 1;
+            break;
+    }
+
+    // Samples
+    std::vector<uint8_t> data;
+
+    if(encoding == WaveEncoding::IMAADPCM) {
+        data.reserve((audio.frameCount / framesPerBlock + 1) * blockAlign);
+        EncodeIMABlocks(audio, framesPerBlock, data);
+    }else {
+        data = GetPCMBytes(audio, bitsPerSample);
+    }
+
+    // Chunks
+    const bool adpcm = (encoding == WaveEncoding::IMAADPCM);
+    const uint32_t fmtSize = adpcm ? 20 : 16;
+    const uint32_t bytesPerSecond = adpcm ?
+        (uint32_t)((uint64_t)audio.sampleRate * blockAlign / framesPerBlock) :
+        audio.sampleRate * blockAlign;
+
+    std::vector<uint8_t> out;
+    out.reserve(data.size() + 64);
+
+    out.insert(out.end(), {'R', 'I', 'F', 'F'});
+    WriteLE32(out, 0); // Set below.
+    out.insert(out.end(), {'W', 'A', 'V', 'E'});
+
+    out.insert(out.end(), {'f', 'm', 't', ' '});
+    WriteLE32(out, fmtSize);
+    WriteLE16(out, format);
+    WriteLE16(out, channels);
+    WriteLE32(out, audio.sampleRate);
+    WriteLE32(out, bytesPerSecond);
+    WriteLE16(out, blockAlign);
+    WriteLE16(out, bitsPerSample);
+
+    if(adpcm) {
+        WriteLE16(out, 2); // Extra format bytes
+        WriteLE16(out, framesPerBlock);
+
+        // The last block is padded, so the real length is given here.
+        out.insert(out.end(), {'f', 'a', 'c', 't'});
+        WriteLE32(out, 4);
+        WriteLE32(out, audio.frameCount);
+    }
+
+    out.insert(out.end(), {'d', 'a', 't', 'a'});
+    WriteLE32(out, data.size());
+    out.insert(out.end(), data.begin(), data.end());
+    if(data.size() & 1) out.push_back(0);
+
+    const uint32_t riffSize = out.size() - 8;
+    for(int i = 0; i < 4; i++) out[4 + i] = (riffSize >> (i * 8)) & 0xFF;
+
+    return out;
+}
\ No newline at end of file
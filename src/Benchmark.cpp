@@ -0,0 +1,126 @@
+#include <GalaMake/Benchmark.hpp>
+#include <GalaMake/Utils.hpp>
+
+#include <iomanip>
+
+// Runs a pass repeatedly for at least GALAMAKE_BENCHMARK_MIN_TIME, returning
+// the average time per pass.
+template<typename F>
+static double TimePasses(F pass) {
+    Timer timer;
+    double total = 0.0;
+    size_t passes = 0;
+
+    do {
+        timer.Start();
+        pass();
+        total += timer.Stop();
+        passes++;
+    } while(total < GALAMAKE_BENCHMARK_MIN_TIME);
+
+    return total / passes;
+}
+
+BenchmarkResult BenchmarkCompression(const std::vector<std::vector<uint8_t>> &samples, Compression compression) {
+    BenchmarkResult result;
+    result.name = GetCompressionString(compression);
+
+    std::vector<std::vector<uint8_t>> encoded(samples.size());
+    std::vector<bool> stored(samples.size(), false);
+    std::vector<uint8_t> decoded;
+
+    for(auto &s : samples)
+        result.inputBytes += s.size();
+
+    result.encodeSecs = TimePasses([&] {
+        for(size_t i = 0; i < samples.size(); i++) {
+            stored[i] = !CompressBytes(samples[i].data(), samples[i].size(), compression, encoded[i]);
+        }
+    });
+
+    for(size_t i = 0; i < samples.size(); i++) {
+        const bool shrank = !stored[i] && (encoded[i].size() < samples[i].size());
+        result.outputBytes += shrank ? encoded[i].size() : samples[i].size(); // As GresTable would save it.
+        if(!stored[i]) result.decodedBytes += samples[i].size();
+    }
+
+    result.decodeSecs = TimePasses([&] {
+        for(size_t i = 0; i < samples.size(); i++) {
+            if(stored[i]) continue;
+
+            if(!DecompressBytes(encoded[i].data(), encoded[i].size(), compression, decoded) || (decoded != samples[i]))
+                result.verified = false;
+        }
+    });
+
+    return result;
+}
+
+BenchmarkResult BenchmarkQOI(const std::vector<ImageSample> &samples, QOIPath path) {
+    BenchmarkResult result;
+    result.name = GetQOIPathString(path);
+
+    std::vector<std::vector<uint8_t>> encoded(samples.size());
+    std::vector<uint8_t> decoded;
+
+    for(auto &s : samples)
+        result.inputBytes += s.pixels.size();
+
+    result.encodeSecs = TimePasses([&] {
+        for(size_t i = 0; i < samples.size(); i++)
+            encoded[i] = EncodeQOI(samples[i].pixels.data(), samples[i].width, samples[i].height, samples[i].channels, path);
+    });
+
+    for(size_t i = 0; i < samples.size(); i++) {
+        result.outputBytes += encoded[i].size();
+
+        const ImageSample &s = samples[i];
+        if(encoded[i] != EncodeQOI(s.pixels.data(), s.width, s.height, s.channels, QOIPath::Scalar))
+            result.verified = false;
+    }
+
+    result.decodedBytes = result.inputBytes;
+    result.decodeSecs = TimePasses([&] {
+        for(size_t i = 0; i < samples.size(); i++) {
+            int width, height, channels;
+
+            if(!DecodeQOI(encoded[i].data(), encoded[i].size(), decoded, width, height, channels) || (decoded != samples[i].pixels))
+                result.verified = false;
+        }
+    });
+
+    return result;
+}
+
+static std::string FormatRate(size_t bytes, double secs) {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << ((secs > 0.0) ? (bytes / secs / 1e6) : 0.0) << " MB/s";
+
+    return ss.str();
+}
+
+void PrintBenchmarkResults(const std::vector<std::pair<std::string, BenchmarkResult>> &results) {
+    std::cout
+        << "    " << std::left
+        << std::setw(10) << "group"
+        << std::setw(10) << "codec"
+        << std::setw(10) << "ratio"
+        << std::setw(16) << "encode"
+        << std::setw(16) << "decode"
+        << std::endl;
+
+    for(auto &[group, r] : results) {
+        std::ostringstream ratio;
+        ratio << std::fixed << std::setprecision(2) << ((r.outputBytes > 0) ? ((double)r.inputBytes / r.outputBytes) : 0.0) << "x";
+
+        std::cout
+            << "    " << std::left
+            << std::setw(10) << group
+            << std::setw(10) << r.name
+            << std::setw(10) << ratio.str()
+            << std::setw(16) << FormatRate(r.inputBytes, r.encodeSecs)
+            << std::setw(16) << FormatRate(r.decodedBytes, r.decodeSecs)
+            << (r.verified ? "" : "\e[1;31mMISMATCH\e[0m")
+            << std::endl;
+    }
+}
\ No newline at end of file
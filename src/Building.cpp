@@ -1,16 +1,139 @@
 #include <GalaMake/Building.hpp>
+#include <GalaMake/QOI.hpp>
+#include <GalaMake/Audio.hpp>
+#include <GalaMake/Resampling.hpp>
+#include <GalaMake/Tracing.hpp>
+#include <GalaMake/Utils.hpp>
+#include <GalaMake/Tiling.hpp>
+#include <GalaMake/Mipmapping.hpp>
+#include <GalaMake/FontBaking.hpp>
+#include <GalaMake/Subsetting.hpp>
+
+bool ReadBuildOptions(const json &buildConfig, BuildOptions &options) {
+    const auto &buildOptions = buildConfig["build_options"];
+
+    if(buildOptions.contains("compression")) {
+        const auto &j_compression = buildOptions["compression"];
+        if(!j_compression.is_object()) return false;
+
+        for(auto &[typeStr, value] : j_compression.items()) {
+            if(g_typeStrs.count(typeStr) == 0) return false;
+            if(!value.is_string()) return false;
+
+            Compression compression;
+            if(!GetCompressionFromString(value.get<std::string>(), compression)) return false;
+
+            options.compression[g_typeStrs[typeStr]] = compression;
+        }
+    }
+
+    if(buildOptions.contains("atlas_size")) {
+        if(!buildOptions["atlas_size"].is_number_integer()) return false;
+
+        const int size = buildOptions["atlas_size"];
+        if((size < 64) || (size > 16384) || ((size & (size - 1)) != 0)) return false; // Power of two.
+
+        options.atlasSize = size;
+    }
+
+    if(buildOptions.contains("predecode_warn_size")) {
+        if(!buildOptions["predecode_warn_size"].is_number_unsigned()) return false;
+
+        options.predecodeWarnSize = buildOptions["predecode_warn_size"];
+    }
+
+    return true;
+}
+
+std::string GetBuildOptionsKey(const BuildOptions &options) {
+    std::string key;
+
+    for(auto &[type, compression] : options.compression) {
+        if(compression != Compression::None)
+            key += GetResourceTypeString(type) + "=" + GetCompressionString(compression) + ";";
+    }
+
+    if(options.atlas)
+        key += "atlas=" + std::to_string(options.atlasSize) + ";";
+
+    return key;
+}
+
+const AtlasPlacement *GetAtlasPlacement(const BuildOptions &options, const ResourceInfo &resource) {
+    if(!options.atlas) return nullptr;
+
+    const auto it = options.atlasPlacements.find(GetResourceTypeString(resource.type) + ":" + resource.name);
+
+    return (it != options.atlasPlacements.end()) ? &it->second : nullptr;
+}
+
+// Points a resource at its place in an atlas page, instead of its own texture.
+static void SetAtlasPlacement(GresTable &gresTable, const AtlasPlacement &placement) {
+    gresTable.SetString("atlas", placement.page);
+    gresTable.SetInt16("atlas_rect.x", placement.x);
+    gresTable.SetInt16("atlas_rect.y", placement.y);
+    gresTable.SetInt16("atlas_rect.w", placement.width);
+    gresTable.SetInt16("atlas_rect.h", placement.height);
+}
+
+static Compression GetCompression(const BuildOptions &options, ResourceType type) {
+    const auto it = options.compression.find(type);
 
-bool BuildTextureResource(const ResourceInfo &resource) {
-    const std::string &sourcePath = resource.paths.inputPath;
-    const std::string &outputFile = resource.paths.outputPath;
+    return (it != options.compression.end()) ? it->second : Compression::None;
+}
+
+// Loads a PNG (or any format raylib reads) and encodes it as QOI.
+static std::vector<uint8_t> LoadTextureAsQOI(const std::string &path) {
+    Image img_texture;
+    {
+        TraceSpan span("decode");
+        img_texture = LoadImage(path.c_str());
+    }
+
+    std::vector<uint8_t> textureData;
+    {
+        TraceSpan span("encode");
+        textureData = EncodeQOI(img_texture);
+    }
+
+    UnloadImage(img_texture);
+
+    return textureData;
+}
+
+// Adds the mip chain below a texture, as QOI images 'mipmap[1]' and onwards.
+// 'mipmap_count' counts every level, the base 'texture' included.
+static bool SetMipmaps(GresTable &gresTable, const RGBAImage &image) {
+    std::vector<RGBAImage> levels;
+    {
+        TraceSpan span("mipmaps");
+        levels = GenerateMipmaps(image);
+    }
+
+    TraceSpan span("encode");
+
+    for(size_t i = 0; i < levels.size(); i++) {
+        std::vector<uint8_t> levelData = EncodeQOI(levels[i].pixels.data(), levels[i].width, levels[i].height, 4);
+        if(levelData.empty()) return false;
+
+        gresTable.SetBytes("mipmap[" + std::to_string(i + 1) + "]", std::move(levelData));
+    }
+
+    gresTable.SetUint16("mipmap_count", levels.size() + 1);
+
+    return true;
+}
+
+bool BuildTextureResource(const ValidatedResource &resource, const BuildOptions &options, std::string * /*note*/) {
+    const std::string &sourcePath = resource.info.paths.inputPath;
+    const std::string &outputFile = resource.info.paths.outputPath;
 
     if(!std::filesystem::exists(sourcePath)) return false;
-    std::filesystem::create_directory(sourcePath + "tmp");
 
     // Check for license
     std::string resourceLicense = "";
-    if(std::filesystem::exists(sourcePath + "LICENSE")) {
-        std::ifstream f_license(sourcePath + "LICENSE");
+    if(resource.contentPaths.count("license") > 0) {
+        std::ifstream f_license(resource.contentPaths.at("license"));
         resourceLicense.assign(
             std::istreambuf_iterator<char>(f_license),
             std::istreambuf_iterator<char>()
@@ -18,18 +141,30 @@ bool BuildTextureResource(const ResourceInfo &resource) {
         f_license.close();
     }
 
-    // Prepare QOI texture
-    Image img_texture = LoadImage(std::string(sourcePath + "texture.png").c_str());
-    if(!ExportImage(img_texture, std::string(sourcePath + "tmp/texture.qoi").c_str())) return false;
+    // Resource information
+    const json &j_data = resource.config;
+    const bool mipmaps = j_data.value("mipmaps", false);
+
+    // Prepare QOI texture (kept decoded for mipmaps, if asked)
+    std::vector<uint8_t> textureData;
+    RGBAImage image;
+
+    if(mipmaps) {
+        {
+            TraceSpan span("decode");
+            if(!LoadRGBAImage(resource.contentPaths.at("texture"), image)) return false;
+        }
+
+        TraceSpan span("encode");
+        textureData = EncodeQOI(image.pixels.data(), image.width, image.height, 4);
+    }else {
+        textureData = LoadTextureAsQOI(resource.contentPaths.at("texture"));
+    }
 
-    // Read resource information
-    std::ifstream f(sourcePath + "resource.json");
-    if(!f.good()) { f.close(); return false; }
-    json j_data = json::parse(f);
-    f.close();
+    if(textureData.empty()) return false;
 
     // Compile gres data
-    xdt::Table gresTable;
+    GresTable gresTable;
 
     gresTable.SetString("type", "texture");
 
@@ -39,15 +174,13 @@ bool BuildTextureResource(const ResourceInfo &resource) {
     if(j_data.count("texture_filter") > 0)
         gresTable.SetString("texture_filter", j_data["texture_filter"]);
 
-    unsigned int textureBytes = 0;
-    const auto textureData = LoadFileData(std::string(sourcePath + "tmp/texture.qoi").c_str(), &textureBytes);
-    gresTable.SetBytes("texture", std::vector<uint8_t>(textureData, textureData + textureBytes));
+    gresTable.SetBytes("texture", std::move(textureData));
 
-    gresTable.Save(outputFile);
+    if(mipmaps && !SetMipmaps(gresTable, image)) return false;
 
-    // Clean up
-    UnloadFileData(textureData);
-    std::filesystem::remove_all(sourcePath + "tmp");
+    gresTable.SetCompression(GetCompression(options, resource.info.type));
+
+    if(!gresTable.Save(outputFile)) return false;
 
     // Verify
     if(!std::filesystem::exists(outputFile)) return false;
@@ -55,36 +188,58 @@ bool BuildTextureResource(const ResourceInfo &resource) {
     return true;
 }
 
-bool BuildSpriteResource(const ResourceInfo &resource) {
-    const std::string &sourcePath = resource.paths.inputPath;
-    const std::string &outputFile = resource.paths.outputPath;
+bool BuildSpriteResource(const ValidatedResource &resource, const BuildOptions &options, std::string * /*note*/) {
+    const std::string &sourcePath = resource.info.paths.inputPath;
+    const std::string &outputFile = resource.info.paths.outputPath;
 
     if(!std::filesystem::exists(sourcePath)) return false;
-    std::filesystem::create_directory(sourcePath + "tmp");
 
     // Check for license
     std::string resourceLicense = "";
-    if(std::filesystem::exists(sourcePath + "LICENSE")) {
-        std::ifstream f_license(sourcePath + "LICENSE");
+    if(resource.contentPaths.count("license") > 0) {
+        std::ifstream f_license(resource.contentPaths.at("license"));
         resourceLicense.assign(
             std::istreambuf_iterator<char>(f_license),
             std::istreambuf_iterator<char>()
         );
         f_license.close();
     }
-    
-    // Prepare QOI texture
-    Image img_texture = LoadImage(std::string(sourcePath + "texture.png").c_str());
-    if(!ExportImage(img_texture, std::string(sourcePath + "tmp/texture.qoi").c_str())) return false;
 
-    // Read resource information
-    std::ifstream f(sourcePath + "resource.json");
-    if(!f.good()) { f.close(); return false; }
-    json j_data = json::parse(f);
-    f.close();
+    // Resource information
+    const json &j_data = resource.config;
+    const bool trim = j_data.value("trim", false);
+
+    std::vector<SpriteFrame> frames = GetSpriteFrames(j_data);
+
+    // Prepare QOI texture (trimmed if asked), unless it went into an atlas page.
+    const AtlasPlacement *placement = GetAtlasPlacement(options, resource.info);
+
+    std::vector<uint8_t> textureData;
+    if(placement) {
+        if(trim) frames = placement->frames;
+    }else if(trim) {
+        RGBAImage image;
+        {
+            TraceSpan span("decode");
+            if(!LoadRGBAImage(resource.contentPaths.at("texture"), image)) return false;
+        }
+
+        {
+            TraceSpan span("trim");
+            image = TrimSpriteFrames(image, frames);
+            if(image.pixels.empty()) return false;
+        }
+
+        TraceSpan span("encode");
+        textureData = EncodeQOI(image.pixels.data(), image.width, image.height, 4);
+        if(textureData.empty()) return false;
+    }else {
+        textureData = LoadTextureAsQOI(resource.contentPaths.at("texture"));
+        if(textureData.empty()) return false;
+    }
 
     // Compile gres data
-    xdt::Table gresTable;
+    GresTable gresTable;
 
     gresTable.SetString("type", "sprite");
 
@@ -96,27 +251,57 @@ bool BuildSpriteResource(const ResourceInfo &resource) {
 
     gresTable.SetInt16("origin_x", j_data["origin"][0]);
     gresTable.SetInt16("origin_y", j_data["origin"][1]);
-    gresTable.SetInt16("frame_count", j_data["frames"].size());
-
-    for(auto i = 0; i < j_data["frames"].size(); i++) {
-        const auto frameStr = std::to_string(i);
-        gresTable.SetInt16("frame[" + frameStr + "].x", j_data["frames"][i][0]);
-        gresTable.SetInt16("frame[" + frameStr + "].y", j_data["frames"][i][1]);
-        gresTable.SetInt16("frame[" + frameStr + "].w", j_data["frames"][i][2]);
-        gresTable.SetInt16("frame[" + frameStr + "].h", j_data["frames"][i][3]);
+
+    // Frames, as one table of packed little-endian int16 {x, y, w, h} records.
+    // Within an atlas page, frames are moved along with the texture.
+    const size_t frameCount = frames.size();
+    auto frameBytes = std::vector<uint8_t>(frameCount * GALAMAKE_SPRITE_FRAME_SIZE, 0x00);
+
+    const int offsetX = placement ? placement->x : 0;
+    const int offsetY = placement ? placement->y : 0;
+
+    for(size_t i = 0; i < frameCount; i++) {
+        const int16_t values[4] = {
+            (int16_t)(frames[i].x + offsetX), (int16_t)(frames[i].y + offsetY),
+            (int16_t)frames[i].width, (int16_t)frames[i].height
+        };
+
+        for(size_t c = 0; c < 4; c++) {
+            frameBytes[i*GALAMAKE_SPRITE_FRAME_SIZE + c*2 + 0] = (values[c] & 0x00FF) >> 0;
+            frameBytes[i*GALAMAKE_SPRITE_FRAME_SIZE + c*2 + 1] = (values[c] & 0xFF00) >> 8;
+        }
     }
 
-    unsigned int textureBytes = 0;
-    const auto textureData = LoadFileData(std::string(sourcePath + "tmp/texture.qoi").c_str(), &textureBytes);
-    gresTable.SetBytes("texture", std::vector<uint8_t>(textureData, textureData + textureBytes));
+    gresTable.SetUint16("frames_version", GALAMAKE_SPRITE_FRAMES_VERSION);
+    gresTable.SetInt16("frame_count", frameCount);
+    gresTable.SetBytes("frames", std::move(frameBytes));
 
-    gresTable.Save(outputFile);
+    // Trimmed frames: where each one sits within its untrimmed frame, as
+    // int16 {offset_x, offset_y, source_w, source_h} records.
+    if(trim) {
+        auto trimBytes = std::vector<uint8_t>(frameCount * GALAMAKE_SPRITE_TRIM_SIZE, 0x00);
 
-    // Clean up
-    UnloadImage(img_texture);
-    UnloadFileData(textureData);
+        for(size_t i = 0; i < frameCount; i++) {
+            const int16_t values[4] = {
+                (int16_t)frames[i].offsetX, (int16_t)frames[i].offsetY,
+                (int16_t)frames[i].sourceWidth, (int16_t)frames[i].sourceHeight
+            };
+
+            for(size_t c = 0; c < 4; c++) {
+                trimBytes[i*GALAMAKE_SPRITE_TRIM_SIZE + c*2 + 0] = (values[c] & 0x00FF) >> 0;
+                trimBytes[i*GALAMAKE_SPRITE_TRIM_SIZE + c*2 + 1] = (values[c] & 0xFF00) >> 8;
+            }
+        }
+
+        gresTable.SetBytes("frame_trims", std::move(trimBytes));
+    }
+
+    if(placement) SetAtlasPlacement(gresTable, *placement);
+    else          gresTable.SetBytes("texture", std::move(textureData));
+
+    gresTable.SetCompression(GetCompression(options, resource.info.type));
 
-    std::filesystem::remove_all(sourcePath + "tmp");
+    if(!gresTable.Save(outputFile)) return false;
 
     // Verify
     if(!std::filesystem::exists(outputFile)) return false;
@@ -124,17 +309,16 @@ bool BuildSpriteResource(const ResourceInfo &resource) {
     return true;
 }
 
-bool BuildTilesetResource(const ResourceInfo &resource) {
-    const std::string &sourcePath = resource.paths.inputPath;
-    const std::string &outputFile = resource.paths.outputPath;
+bool BuildTilesetResource(const ValidatedResource &resource, const BuildOptions &options, std::string *note) {
+    const std::string &sourcePath = resource.info.paths.inputPath;
+    const std::string &outputFile = resource.info.paths.outputPath;
 
     if(!std::filesystem::exists(sourcePath)) return false;
-    std::filesystem::create_directory(sourcePath + "tmp");
 
     // Check for license
     std::string resourceLicense = "";
-    if(std::filesystem::exists(sourcePath + "LICENSE")) {
-        std::ifstream f_license(sourcePath + "LICENSE");
+    if(resource.contentPaths.count("license") > 0) {
+        std::ifstream f_license(resource.contentPaths.at("license"));
         resourceLicense.assign(
             std::istreambuf_iterator<char>(f_license),
             std::istreambuf_iterator<char>()
@@ -142,18 +326,53 @@ bool BuildTilesetResource(const ResourceInfo &resource) {
         f_license.close();
     }
 
-    // Prepare QOI texture
-    Image img_texture = LoadImage(std::string(sourcePath + "texture.png").c_str());
-    if(!ExportImage(img_texture, std::string(sourcePath + "tmp/texture.qoi").c_str())) return false;
+    // Resource information
+    const json &j_data = resource.config;
+    const bool dedup = j_data.value("dedup", false);
+    const bool mipmaps = j_data.value("mipmaps", false);
+
+    // Prepare QOI texture (without duplicate tiles, and kept decoded for
+    // mipmaps, if asked)
+    std::vector<uint8_t> textureData;
+    std::vector<uint16_t> tileRemap;
+    RGBAImage image;
+
+    if(dedup || mipmaps) {
+        {
+            TraceSpan span("decode");
+            if(!LoadRGBAImage(resource.contentPaths.at("texture"), image)) return false;
+        }
+
+        if(dedup) {
+            RGBAImage compacted;
+            {
+                TraceSpan span("dedup");
+                compacted = DeduplicateTiles(image, j_data["tile_size"], tileRemap);
+                if(compacted.pixels.empty()) return false;
+            }
+
+            if(note) {
+                const size_t uniqueTiles = *std::max_element(tileRemap.begin(), tileRemap.end()) + 1;
+                const double savedKiB = ((double)image.pixels.size() - (double)compacted.pixels.size()) / 1024.0;
+
+                char buffer[96];
+                snprintf(buffer, sizeof(buffer), "%zu of %zu tiles unique, %.1f KiB saved", uniqueTiles, tileRemap.size(), savedKiB);
+                *note = buffer;
+            }
+
+            image = std::move(compacted);
+        }
+
+        TraceSpan span("encode");
+        textureData = EncodeQOI(image.pixels.data(), image.width, image.height, 4);
+    }else {
+        textureData = LoadTextureAsQOI(resource.contentPaths.at("texture"));
+    }
 
-    // Read resource information
-    std::ifstream f(sourcePath + "resource.json");
-    if(!f.good()) { f.close(); return false; }
-    json j_data = json::parse(f);
-    f.close();
+    if(textureData.empty()) return false;
 
     // Compile gres data
-    xdt::Table gresTable;
+    GresTable gresTable;
 
     gresTable.SetString("type", "tileset");
 
@@ -170,17 +389,26 @@ bool BuildTilesetResource(const ResourceInfo &resource) {
         flagBytes[i*2 + 1] = (flagData[i] & 0xFF00) >> 8;
     }
 
-    gresTable.SetBytes("flags", flagBytes);
+    gresTable.SetBytes("flags", std::move(flagBytes));
+
+    // Deduplicated: original tile index -> tile in the texture, as uint16s.
+    if(dedup) {
+        auto remapBytes = std::vector<uint8_t>(tileRemap.size() * 2, 0x00);
+
+        for(size_t i = 0; i < tileRemap.size(); i++) {
+            remapBytes[i*2 + 0] = (tileRemap[i] & 0x00FF) >> 0;
+            remapBytes[i*2 + 1] = (tileRemap[i] & 0xFF00) >> 8;
+        }
 
-    unsigned int textureBytes = 0;
-    const auto textureData = LoadFileData(std::string(sourcePath + "tmp/texture.qoi").c_str(), &textureBytes);
-    gresTable.SetBytes("texture", std::vector<uint8_t>(textureData, textureData + textureBytes));
+        gresTable.SetBytes("tile_remap", std::move(remapBytes));
+    }
+
+    gresTable.SetBytes("texture", std::move(textureData));
 
-    gresTable.Save(outputFile);
+    if(mipmaps && !SetMipmaps(gresTable, image)) return false;
+    gresTable.SetCompression(GetCompression(options, resource.info.type));
 
-    // Clean up
-    UnloadFileData(textureData);
-    std::filesystem::remove_all(sourcePath + "tmp");
+    if(!gresTable.Save(outputFile)) return false;
 
     // Verify
     if(!std::filesystem::exists(outputFile)) return false;
@@ -188,17 +416,16 @@ bool BuildTilesetResource(const ResourceInfo &resource) {
     return true;
 }
 
-bool BuildNSliceResource(const ResourceInfo &resource) {
-    const std::string &sourcePath = resource.paths.inputPath;
-    const std::string &outputFile = resource.paths.outputPath;
+bool BuildNSliceResource(const ValidatedResource &resource, const BuildOptions &options, std::string * /*note*/) {
+    const std::string &sourcePath = resource.info.paths.inputPath;
+    const std::string &outputFile = resource.info.paths.outputPath;
 
     if(!std::filesystem::exists(sourcePath)) return false;
-    std::filesystem::create_directory(sourcePath + "tmp");
 
     // Check for license
     std::string resourceLicense = "";
-    if(std::filesystem::exists(sourcePath + "LICENSE")) {
-        std::ifstream f_license(sourcePath + "LICENSE");
+    if(resource.contentPaths.count("license") > 0) {
+        std::ifstream f_license(resource.contentPaths.at("license"));
         resourceLicense.assign(
             std::istreambuf_iterator<char>(f_license),
             std::istreambuf_iterator<char>()
@@ -206,18 +433,20 @@ bool BuildNSliceResource(const ResourceInfo &resource) {
         f_license.close();
     }
 
-    // Prepare QOI texture
-    Image img_texture = LoadImage(std::string(sourcePath + "texture.png").c_str());
-    if(!ExportImage(img_texture, std::string(sourcePath + "tmp/texture.qoi").c_str())) return false;
+    // Prepare QOI texture, unless it went into an atlas page.
+    const AtlasPlacement *placement = GetAtlasPlacement(options, resource.info);
+
+    std::vector<uint8_t> textureData;
+    if(!placement) {
+        textureData = LoadTextureAsQOI(resource.contentPaths.at("texture"));
+        if(textureData.empty()) return false;
+    }
 
-    // Read resource information
-    std::ifstream f(sourcePath + "resource.json");
-    if(!f.good()) { f.close(); return false; }
-    json j_data = json::parse(f);
-    f.close();
+    // Resource information
+    const json &j_data = resource.config;
 
     // Compile gres data
-    xdt::Table gresTable;
+    GresTable gresTable;
 
     gresTable.SetString("type", "nslice");
 
@@ -238,15 +467,13 @@ bool BuildNSliceResource(const ResourceInfo &resource) {
     gresTable.SetBool("stretch_slices.left",   j_data["stretch_slices"][3]);
     gresTable.SetBool("stretch_slices.centre", j_data["stretch_slices"][4]);
 
-    unsigned int textureBytes = 0;
-    const auto textureData = LoadFileData(std::string(sourcePath + "tmp/texture.qoi").c_str(), &textureBytes);
-    gresTable.SetBytes("texture", std::vector<uint8_t>(textureData, textureData + textureBytes));
+    // The centre slice stays relative to the texture, wherever that ends up.
+    if(placement) SetAtlasPlacement(gresTable, *placement);
+    else          gresTable.SetBytes("texture", std::move(textureData));
 
-    gresTable.Save(outputFile);
+    gresTable.SetCompression(GetCompression(options, resource.info.type));
 
-    // Clean up
-    UnloadFileData(textureData);
-    std::filesystem::remove_all(sourcePath + "tmp");
+    if(!gresTable.Save(outputFile)) return false;
 
     // Verify
     if(!std::filesystem::exists(outputFile)) return false;
@@ -254,16 +481,16 @@ bool BuildNSliceResource(const ResourceInfo &resource) {
     return true;
 }
 
-bool BuildSoundResource(const ResourceInfo &resource) {
-    const std::string &sourcePath = resource.paths.inputPath;
-    const std::string &outputFile = resource.paths.outputPath;
+bool BuildSoundResource(const ValidatedResource &resource, const BuildOptions &options, std::string *note, std::string *warning) {
+    const std::string &sourcePath = resource.info.paths.inputPath;
+    const std::string &outputFile = resource.info.paths.outputPath;
 
     if(!std::filesystem::exists(sourcePath)) return false;
 
     // Check for license
     std::string resourceLicense = "";
-    if(std::filesystem::exists(sourcePath + "LICENSE")) {
-        std::ifstream f_license(sourcePath + "LICENSE");
+    if(resource.contentPaths.count("license") > 0) {
+        std::ifstream f_license(resource.contentPaths.at("license"));
         resourceLicense.assign(
             std::istreambuf_iterator<char>(f_license),
             std::istreambuf_iterator<char>()
@@ -278,40 +505,42 @@ bool BuildSoundResource(const ResourceInfo &resource) {
         Ogg
     } audioType = AudioType::Unknown;
 
-    std::string audioPath = "";
+    const std::string &audioPath = resource.contentPaths.at("audio");
+    const std::string audioExt = std::filesystem::path(audioPath).extension().string();
 
-    if(std::filesystem::exists(sourcePath + "audio.ogg")) {
-        audioPath = sourcePath + "audio.ogg";
-        audioType = AudioType::Ogg;
-    }else if(std::filesystem::exists(sourcePath + "audio.wav")){
-        audioPath = sourcePath + "audio.wav";
-        audioType = AudioType::Wave;
-    }
+    if(audioExt == ".ogg")      audioType = AudioType::Ogg;
+    else if(audioExt == ".wav") audioType = AudioType::Wave;
 
     if(audioType == AudioType::Unknown) return false;
 
     // Verify audio
-    bool audioLoadSuccess = true;
-
-    Wave wav_audio = LoadWave(audioPath.c_str());
-    if( (wav_audio.channels == 0) ||
-        (wav_audio.data == NULL) ||
-        (wav_audio.frameCount == 0) ||
-        (wav_audio.sampleRate == 0) ||
-        (wav_audio.sampleSize == 0)
-    ) audioLoadSuccess = false;
-    UnloadWave(wav_audio);
+    AudioInfo audioInfo;
+    bool audioLoadSuccess = false;
+    {
+        TraceSpan span("verify");
+        audioLoadSuccess = options.deepVerify ?
+            DecodeAudioFile(audioPath, audioInfo) :
+            ProbeAudioFile(audioPath, audioInfo);
+    }
 
     if(!audioLoadSuccess) return false;
 
-    // Read resource information
-    std::ifstream f(sourcePath + "resource.json");
-    if(!f.good()) { f.close(); return false; }
-    json j_data = json::parse(f);
-    f.close();
+    // Resource information
+    const json &j_data = resource.config;
+
+    // Re-encoded as a '.wav' when asked to, or when the rate or channels must change.
+    const unsigned int sampleRate = j_data.value("target_sample_rate", audioInfo.sampleRate);
+    const unsigned int channels = j_data.value("channels", audioInfo.channels);
+
+    WaveEncoding encoding = WaveEncoding::PCM16;
+    if(j_data.contains("encoding") && !GetWaveEncodingFromString(j_data["encoding"], encoding)) return false;
+
+    // Predecoded sounds are stored as raw PCM, to play without decoding.
+    const bool predecode = j_data.value("predecode", false);
+    const bool transcode = predecode || j_data.contains("encoding") || (sampleRate != audioInfo.sampleRate) || (channels != audioInfo.channels);
 
     // Compile gres data
-    xdt::Table gresTable;
+    GresTable gresTable;
 
     std::map<AudioType, std::string> typeNames = {
         {AudioType::Ogg, "vorbis"},
@@ -320,19 +549,65 @@ bool BuildSoundResource(const ResourceInfo &resource) {
     };
 
     gresTable.SetString("type", "sound");
-    gresTable.SetString("encoding", typeNames[audioType]);
+    if(predecode) gresTable.SetString("encoding", "pcm");
+    else          gresTable.SetString("encoding", typeNames[transcode ? AudioType::Wave : audioType]);
 
     if(!resourceLicense.empty())
         gresTable.SetString("LICENSE", resourceLicense);
 
-    unsigned int audioBytes = 0;
-    auto audioData = LoadFileData(std::string(audioPath).c_str(), &audioBytes);
-    gresTable.SetBytes("audio", std::vector<uint8_t>(audioData, audioData + audioBytes));
+    if(transcode) {
+        AudioSamples audio;
+        std::vector<uint8_t> audioData;
+        {
+            TraceSpan span("transcode");
+
+            if(!LoadAudioSamples(audioPath, audio)) return false;
+
+            audio = ResampleAudio(MixAudioChannels(audio, channels), sampleRate);
+            audioData = predecode ?
+                GetPCMBytes(audio, (encoding == WaveEncoding::PCM8) ? 8 : 16) :
+                EncodeWave(audio, encoding);
+        }
+
+        if(note) {
+            const double sizeKiB = (double)audioData.size() / 1024.0;
+            const double savedKiB = (double)std::filesystem::file_size(audioPath) / 1024.0 - sizeKiB;
+
+            char buffer[128];
+            if(predecode) {
+                snprintf(buffer, sizeof(buffer), "predecoded, %u Hz %u ch %s, %.1f KiB",
+                    sampleRate, channels, GetWaveEncodingString(encoding).c_str(), sizeKiB);
+            }else {
+                snprintf(buffer, sizeof(buffer), "%u Hz %u ch -> %u Hz %u ch %s, %.1f KiB saved",
+                    audioInfo.sampleRate, audioInfo.channels, sampleRate, channels, GetWaveEncodingString(encoding).c_str(), savedKiB);
+            }
+            *note = buffer;
+        }
+
+        if(predecode && warning && (audioData.size() > options.predecodeWarnSize)) {
+            *warning = "sound '" + resource.info.name + "' predecodes to " + std::to_string(audioData.size() / 1024) +
+                " KiB, over the " + std::to_string(options.predecodeWarnSize / 1024) + " KiB limit ('build_options.predecode_warn_size').";
+        }
+
+        // The layout of raylib's Wave, so the samples can be used where they are.
+        if(predecode) {
+            gresTable.SetUint32("sample_rate", audio.sampleRate);
+            gresTable.SetUint16("channels", audio.channels);
+            gresTable.SetUint16("sample_size", (encoding == WaveEncoding::PCM8) ? 8 : 16);
+            gresTable.SetUint32("frame_count", audio.frameCount);
+        }
+
+        gresTable.SetBytes("audio", std::move(audioData));
+    }else {
+        // Streamed from the source file at save time, never held in memory.
+        if(!gresTable.SetBytesFromFile("audio", audioPath)) return false;
+    }
 
-    gresTable.Save(outputFile);
+    // Predecoded samples stay uncompressed, to be played straight from the mapped file.
+    if(!predecode)
+        gresTable.SetCompression(GetCompression(options, resource.info.type));
 
-    // Clean up
-    UnloadFileData(audioData);
+    if(!gresTable.Save(outputFile)) return false;
 
     // Verify
     if(!std::filesystem::exists(outputFile)) return false;
@@ -340,16 +615,16 @@ bool BuildSoundResource(const ResourceInfo &resource) {
     return true;
 }
 
-bool BuildFontResource(const ResourceInfo &resource) {
-    const std::string &sourcePath = resource.paths.inputPath;
-    const std::string &outputFile = resource.paths.outputPath;
+bool BuildFontResource(const ValidatedResource &resource, const BuildOptions &options, std::string *note) {
+    const std::string &sourcePath = resource.info.paths.inputPath;
+    const std::string &outputFile = resource.info.paths.outputPath;
 
     if(!std::filesystem::exists(sourcePath)) return false;
 
     // Check for license
     std::string resourceLicense = "";
-    if(std::filesystem::exists(sourcePath + "LICENSE")) {
-        std::ifstream f_license(sourcePath + "LICENSE");
+    if(resource.contentPaths.count("license") > 0) {
+        std::ifstream f_license(resource.contentPaths.at("license"));
         resourceLicense.assign(
             std::istreambuf_iterator<char>(f_license),
             std::istreambuf_iterator<char>()
@@ -358,44 +633,110 @@ bool BuildFontResource(const ResourceInfo &resource) {
     }
 
     // Check font file
-    const std::string fontPath = sourcePath + "font.ttf";
+    const std::string &fontPath = resource.contentPaths.at("font");
 
     std::ifstream f_font(fontPath);
     if(!f_font.good()) { f_font.close(); return false; }
     f_font.close();
 
-    // Read resource information
-    std::ifstream f(sourcePath + "resource.json");
-    if(!f.good()) { f.close(); return false; }
-    json j_data = json::parse(f);
-    f.close();
+    // Resource information
+    const json &j_data = resource.config;
 
     // Compile gres data
-    xdt::Table gresTable;
+    GresTable gresTable;
 
     gresTable.SetString("type", "font");
 
     if(!resourceLicense.empty())
         gresTable.SetString("LICENSE", resourceLicense);
 
-    unsigned int fontBytes = 0;
-    auto fontData = LoadFileData(fontPath.c_str(), &fontBytes);
+    // Glyphs pre-rasterised at each of 'sizes' (or as one SDF), as 'baked[i].*' items.
+    const std::vector<int> bakeSizes = GetFontSizes(j_data);
+    const bool subset = j_data.value("subset", false);
+
+    std::vector<uint8_t> fontData;
+    std::vector<int> codepoints;
+
+    if(subset || !bakeSizes.empty()) {
+        std::ifstream f_fontData(fontPath, std::ios::binary);
+        fontData.assign(
+            (std::istreambuf_iterator<char>(f_fontData)),
+            std::istreambuf_iterator<char>()
+        );
+        f_fontData.close();
+
+        codepoints = GetFontCodepoints(j_data);
+
+        if(j_data.contains("codepoint_sources")) {
+            for(auto &source : j_data["codepoint_sources"])
+                if(!AddTextCodepoints(sourcePath + source.get<std::string>(), codepoints)) return false;
+        }
+    }
+
+    // Only the glyphs for the codepoints are kept. Fonts which can't be subset are stored whole.
+    std::vector<uint8_t> subsetData;
+
+    if(subset) {
+        TraceSpan span("subset");
+
+        if(!SubsetFont(fontData, codepoints, subsetData)) {
+            subsetData.clear();
+            if(note) *note = "not subset, no TrueType outlines";
+        }else if(note) {
+            const double savedKiB = ((double)fontData.size() - (double)subsetData.size()) / 1024.0;
+
+            char buffer[96];
+            snprintf(buffer, sizeof(buffer), "subset to %zu codepoints, %.1f KiB saved", codepoints.size(), savedKiB);
+            *note = buffer;
+        }
+    }
+
+    if(!subsetData.empty()) {
+        gresTable.SetBytes("font", std::move(subsetData));
+    }else {
+        // Streamed from the source file at save time, never held in memory.
+        if(!gresTable.SetBytesFromFile("font", fontPath)) return false;
+    }
+
+    if(!bakeSizes.empty()) {
+        const bool sdf = j_data.value("sdf", false);
+        const size_t sizeCount = bakeSizes.size();
+
+        for(size_t i = 0; i < sizeCount; i++) {
+            TraceSpan span("bake");
+
+            BakedFont baked;
+            if(!BakeFont(fontData, bakeSizes[i], codepoints, sdf, options.pool, baked)) return false;
+
+            const std::string prefix = "baked[" + std::to_string(i) + "].";
+
+            gresTable.SetInt16(prefix + "size", baked.size);
+            gresTable.SetBool(prefix + "sdf", baked.sdf);
+            gresTable.SetInt16(prefix + "glyph_padding", baked.glyphPadding);
+            gresTable.SetInt16(prefix + "glyph_count", baked.glyphs.size());
+            gresTable.SetBytes(prefix + "glyphs", GetGlyphTableBytes(baked.glyphs));
+            gresTable.SetBytes(prefix + "kerning", GetKerningTableBytes(baked.kerning));
+            gresTable.SetBytes(prefix + "atlas", std::move(baked.atlasData));
+        }
+
+        gresTable.SetUint16("baked_count", sizeCount);
+    }
 
-    gresTable.SetBytes("font", std::vector<uint8_t>(fontData, fontData + fontBytes));
+    gresTable.SetCompression(GetCompression(options, resource.info.type));
 
-    gresTable.Save(outputFile);
+    if(!gresTable.Save(outputFile)) return false;
 
     return true;
 }
 
-bool BuildResource(const ResourceInfo &resource) {
-    switch(resource.type) {
-        case ResourceType::Texture: return BuildTextureResource(resource); break;
-        case ResourceType::Sprite:  return BuildSpriteResource(resource); break;
-        case ResourceType::Tileset: return BuildTilesetResource(resource); break;
-        case ResourceType::NSlice:  return BuildNSliceResource(resource); break;
-        case ResourceType::Sound:   return BuildSoundResource(resource); break;
-        case ResourceType::Font:    return BuildFontResource(resource); break;
+bool BuildResource(const ValidatedResource &resource, const BuildOptions &options, std::string *note, std::string *warning) {
+    switch(resource.info.type) {
+        case ResourceType::Texture: return BuildTextureResource(resource, options, note); break;
+        case ResourceType::Sprite:  return BuildSpriteResource(resource, options, note); break;
+        case ResourceType::Tileset: return BuildTilesetResource(resource, options, note); break;
+        case ResourceType::NSlice:  return BuildNSliceResource(resource, options, note); break;
+        case ResourceType::Sound:   return BuildSoundResource(resource, options, note, warning); break;
+        case ResourceType::Font:    return BuildFontResource(resource, options, note); break;
         default:
             return false;
             break;
@@ -0,0 +1,317 @@
+#include <GalaMake/Caching.hpp>
+#include <GalaMake/Utils.hpp>
+#include <GalaMake/Writing.hpp>
+
+#include <thread>
+#include <unistd.h>
+
+static std::string GetResourceKey(const ResourceInfo &resource) {
+    return GetResourceTypeString(resource.type) + ":" + resource.name;
+}
+
+static int64_t GetModifiedTime(const std::string &path) {
+    std::error_code ec;
+    const auto time = std::filesystem::last_write_time(path, ec);
+    if(ec) return 0;
+
+    return time.time_since_epoch().count();
+}
+
+std::vector<std::string> GetResourceInputFiles(const ResourceInfo &resource) {
+    std::vector<std::string> candidates = {"resource.json", "LICENSE"};
+
+    switch(resource.type) {
+        case ResourceType::Texture:
+        case ResourceType::Sprite:
+        case ResourceType::Tileset:
+        case ResourceType::NSlice:
+            candidates.push_back("texture.png");
+            break;
+        case ResourceType::Sound:
+            candidates.push_back("audio.ogg");
+            candidates.push_back("audio.wav");
+            break;
+        case ResourceType::Font: {
+            candidates.push_back("font.ttf");
+
+            // Text scanned for codepoints, which may live outside the resource.
+            std::ifstream f(resource.paths.inputPath + "resource.json");
+            const json config = json::parse(f, nullptr, false);
+
+            if(config.is_object() && config.contains("codepoint_sources") && config["codepoint_sources"].is_array()) {
+                for(auto &source : config["codepoint_sources"])
+                    if(source.is_string()) candidates.push_back(source.get<std::string>());
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    std::vector<std::string> out;
+
+    for(auto &name : candidates) {
+        if(std::filesystem::is_regular_file(resource.paths.inputPath + name))
+            out.push_back(name);
+    }
+
+    return out;
+}
+
+static bool IsEntryCurrent(const ResourceInfo &resource, json &entry, bool &refreshed) {
+    // Output
+    std::error_code ec;
+    const std::string &outputPath = resource.paths.outputPath;
+
+    if(entry["output"] != outputPath) return false;
+    if(!std::filesystem::is_regular_file(outputPath, ec)) return false;
+    if(std::filesystem::file_size(outputPath, ec) != entry["output_size"].get<uintmax_t>()) return false;
+
+    // Inputs
+    const auto inputs = GetResourceInputFiles(resource);
+    if(inputs.size() != entry["inputs"].size()) return false;
+
+    for(auto &name : inputs) {
+        if(!entry["inputs"].contains(name)) return false;
+
+        json &record = entry["inputs"][name];
+        const std::string path = resource.paths.inputPath + name;
+
+        const uintmax_t size = std::filesystem::file_size(path, ec);
+        if(ec || (size != record["size"].get<uintmax_t>())) return false;
+
+        const int64_t mtime = GetModifiedTime(path);
+        if(mtime == record["mtime"].get<int64_t>()) continue;
+
+        // Touched, but maybe not changed.
+        uint64_t hash = 0;
+        if(!HashFile(path, hash)) return false;
+        if(hash != record["hash"].get<uint64_t>()) return false;
+
+        record["mtime"] = mtime;
+        refreshed = true;
+    }
+
+    return true;
+}
+
+bool BuildCache::IsUpToDate(const ResourceInfo &resource) {
+    const std::string key = GetResourceKey(resource);
+
+    json entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!entries.contains(key)) return false;
+        entry = entries[key];
+    }
+
+    bool refreshed = false;
+
+    try {
+        if(!IsEntryCurrent(resource, entry, refreshed)) return false;
+    } catch(json::exception &e) {
+        return false;
+    }
+
+    // Inputs were touched without changing; remember their new times.
+    if(refreshed) {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries[key] = entry;
+        modified = true;
+    }
+
+    return true;
+}
+
+bool BuildCache::Update(const ResourceInfo &resource) {
+    std::error_code ec;
+
+    json entry;
+    entry["output"] = resource.paths.outputPath;
+    entry["output_size"] = std::filesystem::file_size(resource.paths.outputPath, ec);
+    if(ec) { Invalidate(resource); return false; }
+
+    entry["inputs"] = json::object();
+
+    for(auto &name : GetResourceInputFiles(resource)) {
+        const std::string path = resource.paths.inputPath + name;
+
+        uint64_t hash = 0;
+        if(!HashFile(path, hash)) { Invalidate(resource); return false; }
+
+        entry["inputs"][name] = {
+            {"size", std::filesystem::file_size(path, ec)},
+            {"mtime", GetModifiedTime(path)},
+            {"hash", hash}
+        };
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    entries[GetResourceKey(resource)] = entry;
+    modified = true;
+
+    return true;
+}
+
+void BuildCache::Invalidate(const ResourceInfo &resource) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if(entries.erase(GetResourceKey(resource)) > 0)
+        modified = true;
+}
+
+bool BuildCache::Load(const std::string &filename, const std::string &buildKey) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries = json::object();
+    modified = false;
+    this->buildKey = buildKey;
+
+    std::ifstream f(filename);
+    if(!f.good()) return false;
+
+    json j_cache;
+    try {
+        j_cache = json::parse(f);
+    } catch(json::exception &e) {
+        return false;
+    }
+    f.close();
+
+    // Builds from other versions of GalaMake may differ; start over.
+    if(j_cache.value("version", "") != GALAMAKE_VERSION) return false;
+    if(j_cache.value("build_key", "") != buildKey) return false;
+    if(!j_cache["resources"].is_object()) return false;
+
+    entries = j_cache["resources"];
+
+    return true;
+}
+
+bool BuildCache::Save(const std::string &filename) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(!modified) return true;
+
+    const auto parentDir = std::filesystem::path(filename).parent_path();
+    if(!parentDir.empty()) std::filesystem::create_directories(parentDir);
+
+    json j_cache = {
+        {"version", GALAMAKE_VERSION},
+        {"build_key", buildKey},
+        {"resources", entries}
+    };
+
+    std::ofstream f(filename);
+    if(!f.good()) return false;
+    f << j_cache.dump();
+    f.close();
+
+    modified = false;
+
+    return true;
+}
+
+BuildCache::BuildCache() : entries(json::object()) {}
+
+// Shared cache
+std::string GetSharedCacheDirectory(const json &buildConfig) {
+    const auto &buildOptions = buildConfig["build_options"];
+
+    if(buildOptions.contains("shared_cache_dir") && buildOptions["shared_cache_dir"].is_string())
+        return buildOptions["shared_cache_dir"].get<std::string>();
+
+    return "";
+}
+
+bool SharedCache::Open(const std::string &directory, const std::string &buildKey) {
+    this->directory.clear();
+    this->buildKey = buildKey;
+
+    if(directory.empty()) return false;
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if(!std::filesystem::is_directory(directory, ec)) return false;
+
+    this->directory = directory;
+    if(this->directory.back() != '/') this->directory += '/';
+
+    return true;
+}
+
+bool SharedCache::IsOpen() const {
+    return !directory.empty();
+}
+
+std::string SharedCache::GetEntryPath(const std::string &key) const {
+    // Fanned out by the first byte, so no one directory grows too large.
+    return directory + key.substr(0, 2) + "/" + key + ".gres";
+}
+
+bool SharedCache::GetKey(const ResourceInfo &resource, std::string &key) const {
+    Hasher hasher;
+
+    auto add = [&](const std::string &str) {
+        const uint64_t size = str.size();
+        hasher.Update(&size, sizeof(size));
+        hasher.Update(str.data(), str.size());
+    };
+
+    add(GALAMAKE_VERSION);
+    add(buildKey);
+    add(GetResourceTypeString(resource.type));
+
+    for(auto &name : GetResourceInputFiles(resource)) {
+        uint64_t hash = 0;
+        if(!HashFile(resource.paths.inputPath + name, hash)) return false;
+
+        add(name);
+        hasher.Update(&hash, sizeof(hash));
+    }
+
+    char buffer[17];
+    snprintf(buffer, sizeof(buffer), "%016llx", (unsigned long long)hasher.Finish());
+    key = buffer;
+
+    return true;
+}
+
+// Copies to a temporary name first, so other processes (or machines) never
+// see a partly written file.
+static bool CloneFileAtomic(const std::string &from, const std::string &to) {
+    const std::string tempPath = to + ".tmp" +
+        std::to_string(getpid()) + "-" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+    std::error_code ec;
+
+    if(!CloneFile(from, tempPath)) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    std::filesystem::rename(tempPath, to, ec);
+    if(ec) std::filesystem::remove(tempPath, ec);
+
+    return !ec;
+}
+
+bool SharedCache::Fetch(const std::string &key, const ResourceInfo &resource) const {
+    if(!IsOpen()) return false;
+
+    std::error_code ec;
+    const std::string entryPath = GetEntryPath(key);
+    if(!std::filesystem::is_regular_file(entryPath, ec)) return false;
+
+    return CloneFileAtomic(entryPath, resource.paths.outputPath);
+}
+
+bool SharedCache::Store(const std::string &key, const ResourceInfo &resource) const {
+    if(!IsOpen()) return false;
+
+    std::error_code ec;
+    const std::string entryPath = GetEntryPath(key);
+    if(std::filesystem::is_regular_file(entryPath, ec)) return true; // Someone got here first.
+
+    std::filesystem::create_directories(std::filesystem::path(entryPath).parent_path(), ec);
+
+    return CloneFileAtomic(resource.paths.outputPath, entryPath);
+}
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include <GalaMake/Checking.hpp>
+#include <GalaMake/FontBaking.hpp>
+#include <GalaMake/Audio.hpp>
 
 std::string GetResourceCheckErrorString(const ResourceCheckError &error) {
     switch(error) {
@@ -12,158 +14,307 @@ std::string GetResourceCheckErrorString(const ResourceCheckError &error) {
     return "UNKNOWN";
 }
 
-ResourceCheckError CheckTextureResourceIntegrity(const ResourceInfo &resource) {
-    if(!std::filesystem::exists(resource.paths.inputPath + "resource.json"))
-        return ResourceCheckError::MissingConfig;
+std::string GetResourceCheckErrorString(const ResourceCheckError &error, const std::string &failedField) {
+    if(failedField.empty()) return GetResourceCheckErrorString(error);
 
-    if(!std::filesystem::exists(resource.paths.inputPath + "texture.png"))
-        return ResourceCheckError::MissingContent;
+    return GetResourceCheckErrorString(error) + " (" + failedField + ")";
+}
 
-    return ResourceCheckError::None;
+static ResourceCheckError FailField(ValidatedResource &validated, ResourceCheckError error, const std::string &field) {
+    validated.failedField = field;
+
+    return error;
 }
 
-ResourceCheckError CheckSpriteResourceIntegrity(const ResourceInfo &resource) {
-    if(!std::filesystem::exists(resource.paths.inputPath + "resource.json"))
-        return ResourceCheckError::MissingConfig;
+static std::string IndexStr(const std::string &field, size_t index) {
+    return field + "[" + std::to_string(index) + "]";
+}
 
-    if(!std::filesystem::exists(resource.paths.inputPath + "texture.png"))
-        return ResourceCheckError::MissingContent;
+// Looks for 'resource.json' and the given content file, then parses the config.
+static ResourceCheckError CheckCommon(const ResourceInfo &resource, ValidatedResource &validated, const std::string &contentName, const std::string &contentFile) {
+    const std::string configPath  = resource.paths.inputPath + "resource.json";
+    const std::string licensePath = resource.paths.inputPath + "LICENSE";
 
-    // Config checking
-    json config;
-    std::ifstream f(resource.paths.inputPath + "resource.json");
+    validated = ValidatedResource {};
+    validated.info = resource;
+
+    if(!std::filesystem::exists(configPath))
+        return FailField(validated, ResourceCheckError::MissingConfig, "resource.json");
+
+    if(!contentFile.empty()) {
+        if(!std::filesystem::exists(resource.paths.inputPath + contentFile))
+            return FailField(validated, ResourceCheckError::MissingContent, contentFile);
+
+        validated.contentPaths[contentName] = resource.paths.inputPath + contentFile;
+    }
+
+    std::ifstream f(configPath);
     try {
-        config = json::parse(f);
+        validated.config = json::parse(f);
     } catch(json::exception &e) {
-        return ResourceCheckError::InvalidConfig;
+        return FailField(validated, ResourceCheckError::InvalidConfig, "resource.json");
     }
     f.close();
 
-    if((config.count("origin") < 1) || (config.count("frames") < 1))
-        return ResourceCheckError::InvalidConfig;
+    if(!validated.config.is_object())
+        return FailField(validated, ResourceCheckError::InvalidConfig, "resource.json");
+
+    if(validated.config.contains("texture_filter") && !validated.config["texture_filter"].is_string())
+        return FailField(validated, ResourceCheckError::InvalidConfig, "texture_filter");
 
-    if(config["origin"].size() < 2)
-        return ResourceCheckError::InvalidConfig;
+    validated.contentPaths["config"] = configPath;
 
-    if( (!config["origin"][0].is_number()) ||
-        (!config["origin"][1].is_number())
-    ) return ResourceCheckError::InvalidConfig;
+    if(std::filesystem::exists(licensePath))
+        validated.contentPaths["license"] = licensePath;
 
-    if(config["frames"].size() < 1)
-        return ResourceCheckError::InvalidConfig;
+    return ResourceCheckError::None;
+}
+
+ResourceCheckError CheckTextureResourceIntegrity(const ResourceInfo &resource, ValidatedResource &validated) {
+    const ResourceCheckError commonError = CheckCommon(resource, validated, "texture", "texture.png");
+    if(commonError != ResourceCheckError::None) return commonError;
+
+    // Config checking
+    const json &config = validated.config;
+
+    if(config.contains("mipmaps") && !config["mipmaps"].is_boolean())
+        return FailField(validated, ResourceCheckError::InvalidConfig, "mipmaps");
 
-    for(auto &f : config["frames"]) {
-        if(!f.is_array())
-            return ResourceCheckError::InvalidConfig;
-        
-        if(f.size() < 4)
-            return ResourceCheckError::InvalidConfig;
+    return ResourceCheckError::None;
+}
+
+ResourceCheckError CheckSpriteResourceIntegrity(const ResourceInfo &resource, ValidatedResource &validated) {
+    const ResourceCheckError commonError = CheckCommon(resource, validated, "texture", "texture.png");
+    if(commonError != ResourceCheckError::None) return commonError;
+
+    // Config checking
+    const json &config = validated.config;
 
-        for(auto &e : f) {
-            if(!e.is_number())
-                return ResourceCheckError::InvalidConfig;
+    if(!config.contains("origin") || !config["origin"].is_array() || (config["origin"].size() < 2))
+        return FailField(validated, ResourceCheckError::InvalidConfig, "origin");
+
+    for(size_t i = 0; i < 2; i++) {
+        if(!config["origin"][i].is_number())
+            return FailField(validated, ResourceCheckError::InvalidConfig, IndexStr("origin", i));
+    }
+
+    if(!config.contains("frames") || !config["frames"].is_array() || (config["frames"].size() < 1))
+        return FailField(validated, ResourceCheckError::InvalidConfig, "frames");
+
+    for(size_t i = 0; i < config["frames"].size(); i++) {
+        const json &f = config["frames"][i];
+
+        if(!f.is_array() || (f.size() < 4))
+            return FailField(validated, ResourceCheckError::InvalidConfig, IndexStr("frames", i));
+
+        for(size_t e = 0; e < f.size(); e++) {
+            if(!f[e].is_number())
+                return FailField(validated, ResourceCheckError::InvalidConfig, IndexStr(IndexStr("frames", i), e));
         }
     }
 
+    if(config.contains("trim") && !config["trim"].is_boolean())
+        return FailField(validated, ResourceCheckError::InvalidConfig, "trim");
+
     return ResourceCheckError::None;
 }
 
-ResourceCheckError CheckTilesetResourceIntegrity(const ResourceInfo &resource) {
-    if(!std::filesystem::exists(resource.paths.inputPath + "resource.json"))
-        return ResourceCheckError::MissingConfig;
+ResourceCheckError CheckTilesetResourceIntegrity(const ResourceInfo &resource, ValidatedResource &validated) {
+    const ResourceCheckError commonError = CheckCommon(resource, validated, "texture", "texture.png");
+    if(commonError != ResourceCheckError::None) return commonError;
 
-    if(!std::filesystem::exists(resource.paths.inputPath + "texture.png"))
-        return ResourceCheckError::MissingContent;
+    // Config checking
+    const json &config = validated.config;
 
-    json config;
-    std::ifstream f(resource.paths.inputPath + "resource.json");
-    try {
-        config = json::parse(f);
-    } catch(json::exception &e) {
-        return ResourceCheckError::InvalidConfig;
+    if(!config.contains("tile_size") || !config["tile_size"].is_number())
+        return FailField(validated, ResourceCheckError::InvalidConfig, "tile_size");
+
+    if(!config.contains("flags") || !config["flags"].is_array())
+        return FailField(validated, ResourceCheckError::InvalidConfig, "flags");
+
+    for(size_t i = 0; i < config["flags"].size(); i++) {
+        if(!config["flags"][i].is_number())
+            return FailField(validated, ResourceCheckError::InvalidConfig, IndexStr("flags", i));
     }
-    f.close();
 
-    if(config.count("tile_size") < 1)
-        return ResourceCheckError::InvalidConfig;
+    if(config.contains("dedup") && !config["dedup"].is_boolean())
+        return FailField(validated, ResourceCheckError::InvalidConfig, "dedup");
+
+    if(config.contains("mipmaps") && !config["mipmaps"].is_boolean())
+        return FailField(validated, ResourceCheckError::InvalidConfig, "mipmaps");
+
+    return ResourceCheckError::None;
+}
+
+ResourceCheckError CheckNSliceResourceIntegrity(const ResourceInfo &resource, ValidatedResource &validated) {
+    const ResourceCheckError commonError = CheckCommon(resource, validated, "texture", "texture.png");
+    if(commonError != ResourceCheckError::None) return commonError;
 
-    if(!config["tile_size"].is_number())
-        return ResourceCheckError::InvalidConfig;
+    // Config checking
+    const json &config = validated.config;
 
-    if(config.count("flags") < 1)
-        return ResourceCheckError::InvalidConfig;
+    if(!config.contains("centre_slice") || !config["centre_slice"].is_array() || (config["centre_slice"].size() < 4))
+        return FailField(validated, ResourceCheckError::InvalidConfig, "centre_slice");
+
+    for(size_t i = 0; i < 4; i++) {
+        if(!config["centre_slice"][i].is_number())
+            return FailField(validated, ResourceCheckError::InvalidConfig, IndexStr("centre_slice", i));
+    }
 
-    if(!config["flags"].is_array())
-        return ResourceCheckError::InvalidConfig;
+    if(!config.contains("stretch_slices") || !config["stretch_slices"].is_array() || (config["stretch_slices"].size() < 5))
+        return FailField(validated, ResourceCheckError::InvalidConfig, "stretch_slices");
 
-    for(auto &f : config["flags"]) {
-        if(!f.is_number())
-            return ResourceCheckError::InvalidConfig;
+    for(size_t i = 0; i < 5; i++) {
+        if(!config["stretch_slices"][i].is_boolean())
+            return FailField(validated, ResourceCheckError::InvalidConfig, IndexStr("stretch_slices", i));
     }
 
     return ResourceCheckError::None;
 }
 
-ResourceCheckError CheckNSliceResourceIntegrity(const ResourceInfo &resource) {
-    if(!std::filesystem::exists(resource.paths.inputPath + "resource.json"))
-        return ResourceCheckError::MissingConfig;
+ResourceCheckError CheckSoundResourceIntegrity(const ResourceInfo &resource, ValidatedResource &validated) {
+    const bool hasOgg = std::filesystem::exists(resource.paths.inputPath + "audio.ogg");
+    const bool hasWav = std::filesystem::exists(resource.paths.inputPath + "audio.wav");
 
-    if(!std::filesystem::exists(resource.paths.inputPath + "texture.png"))
-        return ResourceCheckError::MissingContent;
+    if(!(hasOgg || hasWav)) {
+        validated = ValidatedResource {};
+        validated.info = resource;
+
+        if(!std::filesystem::exists(resource.paths.inputPath + "resource.json"))
+            return FailField(validated, ResourceCheckError::MissingConfig, "resource.json");
+
+        return FailField(validated, ResourceCheckError::MissingContent, "audio.ogg/audio.wav");
+    }
+
+    // Ogg is preferred when both exist.
+    const ResourceCheckError commonError = CheckCommon(resource, validated, "audio", hasOgg ? "audio.ogg" : "audio.wav");
+    if(commonError != ResourceCheckError::None) return commonError;
 
     // Config checking
-    json config;
-    std::ifstream f(resource.paths.inputPath + "resource.json");
-    try {
-        config = json::parse(f);
-    } catch(json::exception &e) {
-        return ResourceCheckError::InvalidConfig;
+    const json &config = validated.config;
+
+    if(config.contains("target_sample_rate")) {
+        const json &rate = config["target_sample_rate"];
+
+        if(!rate.is_number_integer() || (rate.get<int64_t>() < 8000) || (rate.get<int64_t>() > 192000))
+            return FailField(validated, ResourceCheckError::InvalidConfig, "target_sample_rate");
     }
-    f.close();
 
-    if(config.count("centre_slice") < 1)    return ResourceCheckError::InvalidConfig;
-    if(config["centre_slice"].size() < 4)   return ResourceCheckError::InvalidConfig;
+    if(config.contains("channels")) {
+        const json &channels = config["channels"];
 
-    if(config.count("stretch_slices") < 1)  return ResourceCheckError::InvalidConfig;
-    if(config["stretch_slices"].size() < 5) return ResourceCheckError::InvalidConfig;
+        if(!channels.is_number_integer() || ((channels.get<int64_t>() != 1) && (channels.get<int64_t>() != 2)))
+            return FailField(validated, ResourceCheckError::InvalidConfig, "channels");
+    }
 
-    return ResourceCheckError::None;
-}
+    if(config.contains("predecode") && !config["predecode"].is_boolean())
+        return FailField(validated, ResourceCheckError::InvalidConfig, "predecode");
 
-ResourceCheckError CheckSoundResourceIntegrity(const ResourceInfo &resource) {
-    if(!std::filesystem::exists(resource.paths.inputPath + "resource.json"))
-        return ResourceCheckError::MissingConfig;
+    if(config.contains("encoding")) {
+        WaveEncoding encoding;
+        if(!config["encoding"].is_string() || !GetWaveEncodingFromString(config["encoding"].get<std::string>(), encoding))
+            return FailField(validated, ResourceCheckError::InvalidConfig, "encoding");
 
-    if(!(
-        std::filesystem::exists(resource.paths.inputPath + "audio.ogg") ||
-        std::filesystem::exists(resource.paths.inputPath + "audio.wav")
-    )) return ResourceCheckError::MissingContent;
+        // Predecoded samples are PCM.
+        if(config.value("predecode", false) && (encoding == WaveEncoding::IMAADPCM))
+            return FailField(validated, ResourceCheckError::InvalidConfig, "encoding");
+    }
 
     return ResourceCheckError::None;
 }
 
-ResourceCheckError CheckFontResourceIntegrity(const ResourceInfo &resource) {
-    if(!std::filesystem::exists(resource.paths.inputPath + "resource.json"))
-        return ResourceCheckError::MissingConfig;
+ResourceCheckError CheckFontResourceIntegrity(const ResourceInfo &resource, ValidatedResource &validated) {
+    const ResourceCheckError commonError = CheckCommon(resource, validated, "font", "font.ttf");
+    if(commonError != ResourceCheckError::None) return commonError;
+
+    // Config checking
+    const json &config = validated.config;
+
+    if(config.contains("sizes")) {
+        if(!config["sizes"].is_array())
+            return FailField(validated, ResourceCheckError::InvalidConfig, "sizes");
+
+        for(size_t i = 0; i < config["sizes"].size(); i++) {
+            const json &size = config["sizes"][i];
+
+            if(!size.is_number_integer() || (size.get<int>() < 1) || (size.get<int>() > 1024))
+                return FailField(validated, ResourceCheckError::InvalidConfig, IndexStr("sizes", i));
+        }
+    }
+
+    if(config.contains("sdf") && !config["sdf"].is_boolean())
+        return FailField(validated, ResourceCheckError::InvalidConfig, "sdf");
+
+    if(config.contains("codepoints")) {
+        if(!config["codepoints"].is_array())
+            return FailField(validated, ResourceCheckError::InvalidConfig, "codepoints");
 
-    if(!std::filesystem::exists(resource.paths.inputPath + "font.ttf"))
-        return ResourceCheckError::MissingContent;
+        auto isCodepoint = [](const json &c) {
+            return c.is_number_integer() && (c.get<int64_t>() >= 0) && (c.get<int64_t>() <= 0x10FFFF);
+        };
+
+        size_t total = 0;
+
+        for(size_t i = 0; i < config["codepoints"].size(); i++) {
+            const json &entry = config["codepoints"][i];
+
+            if(entry.is_array()) {
+                if((entry.size() != 2) || !isCodepoint(entry[0]) || !isCodepoint(entry[1]) || (entry[0] > entry[1]))
+                    return FailField(validated, ResourceCheckError::InvalidConfig, IndexStr("codepoints", i));
+
+                total += entry[1].get<int>() - entry[0].get<int>() + 1;
+            }else {
+                if(!isCodepoint(entry))
+                    return FailField(validated, ResourceCheckError::InvalidConfig, IndexStr("codepoints", i));
+
+                total++;
+            }
+        }
+
+        if(total > GALAMAKE_FONT_MAX_CODEPOINTS)
+            return FailField(validated, ResourceCheckError::InvalidConfig, "codepoints");
+    }
+
+    // Text files, relative to the resource directory.
+    if(config.contains("codepoint_sources")) {
+        if(!config["codepoint_sources"].is_array())
+            return FailField(validated, ResourceCheckError::InvalidConfig, "codepoint_sources");
+
+        for(size_t i = 0; i < config["codepoint_sources"].size(); i++) {
+            const json &source = config["codepoint_sources"][i];
+
+            if(!source.is_string())
+                return FailField(validated, ResourceCheckError::InvalidConfig, IndexStr("codepoint_sources", i));
+
+            if(!std::filesystem::is_regular_file(resource.paths.inputPath + source.get<std::string>()))
+                return FailField(validated, ResourceCheckError::MissingContent, IndexStr("codepoint_sources", i));
+        }
+    }
+
+    if(config.contains("subset") && !config["subset"].is_boolean())
+        return FailField(validated, ResourceCheckError::InvalidConfig, "subset");
 
     return ResourceCheckError::None;
 }
 
-ResourceCheckError CheckResourceIntegrity(const ResourceInfo &resource) {
+ResourceCheckError CheckResourceIntegrity(const ResourceInfo &resource, ValidatedResource &validated) {
     switch(resource.type) {
-        case ResourceType::Texture: return CheckTextureResourceIntegrity(resource); break;
-        case ResourceType::Sprite:  return CheckSpriteResourceIntegrity(resource); break;
-        case ResourceType::Tileset: return CheckTilesetResourceIntegrity(resource); break;
-        case ResourceType::NSlice:  return CheckNSliceResourceIntegrity(resource); break;
-        case ResourceType::Sound:   return CheckSoundResourceIntegrity(resource); break;
-        case ResourceType::Font:    return CheckFontResourceIntegrity(resource); break;
+        case ResourceType::Texture: return CheckTextureResourceIntegrity(resource, validated); break;
+        case ResourceType::Sprite:  return CheckSpriteResourceIntegrity(resource, validated); break;
+        case ResourceType::Tileset: return CheckTilesetResourceIntegrity(resource, validated); break;
+        case ResourceType::NSlice:  return CheckNSliceResourceIntegrity(resource, validated); break;
+        case ResourceType::Sound:   return CheckSoundResourceIntegrity(resource, validated); break;
+        case ResourceType::Font:    return CheckFontResourceIntegrity(resource, validated); break;
         default:
             return ResourceCheckError::None;
             break;
     }
 
     return ResourceCheckError::None;
-}
\ No newline at end of file
+}
+
+ResourceCheckError CheckResourceIntegrity(const ResourceInfo &resource) {
+    ValidatedResource validated;
+
+    return CheckResourceIntegrity(resource, validated);
+}
@@ -0,0 +1,294 @@
+#include <GalaMake/Compression.hpp>
+
+#include <cstring>
+
+#define LZ_MIN_MATCH        4
+#define LZ_LAST_LITERALS    5   // A block always ends in at least this many literals...
+#define LZ_MATCH_LIMIT      12  // ...and no match starts within this many bytes of its end.
+#define LZ_MAX_OFFSET       65535
+#define LZ_HASH_BITS        16
+#define LZ_SIZE_PREFIX      4
+#define LZ_MAX_RATIO        255 // Most output a payload byte can produce (a 255 match length byte).
+
+static std::map<std::string, Compression> s_compressionStrs = {
+    {"none",    Compression::None},
+    {"rle",     Compression::RLE},
+    {"lz77",    Compression::LZ77},
+    {"deflate", Compression::Deflate}
+};
+
+bool GetCompressionFromString(const std::string &str, Compression &compression) {
+    if(s_compressionStrs.count(str) == 0) return false;
+
+    compression = s_compressionStrs[str];
+    return true;
+}
+
+std::string GetCompressionString(Compression compression) {
+    for(auto &[str, c] : s_compressionStrs)
+        if(c == compression) return str;
+
+    return "none";
+}
+
+Compression GetItemCompression(const xdt::ItemFlags &flags) {
+    return (Compression)(XDT_GET_ITEM_COMPRESION(flags) >> GALAMAKE_COMPRESSION_SHIFT);
+}
+
+void SetItemCompression(xdt::ItemFlags &flags, Compression compression) {
+    flags.low = (flags.low & ~0b11000000) | ((uint8_t)compression << GALAMAKE_COMPRESSION_SHIFT);
+}
+
+// Helpers
+static inline uint32_t ReadUint32LE(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void WriteUint32LE(std::vector<uint8_t> &out, uint32_t value) {
+    for(int i = 0; i < 4; i++)
+        out.push_back((value >> (i * 8)) & 0xFF);
+}
+
+static inline void WriteLength(std::vector<uint8_t> &out, size_t length) {
+    for(; length >= 255; length -= 255)
+        out.push_back(255);
+
+    out.push_back(length);
+}
+
+static inline bool ReadLength(const uint8_t *&p, const uint8_t *end, size_t &length) {
+    uint8_t b;
+
+    do {
+        if(p >= end) return false;
+        b = *p++;
+        length += b;
+    } while(b == 255);
+
+    return true;
+}
+
+// RLE
+// Same format as xdt::CompressRLE, whose runs of over 255 bytes wrap around.
+static void CompressRLE(const uint8_t *data, size_t size, std::vector<uint8_t> &out) {
+    for(size_t i = 0; i < size;) {
+        size_t run = 1;
+        while((i + run < size) && (run < 255) && (data[i + run] == data[i]))
+            run++;
+
+        out.push_back(data[i]);
+        out.push_back(run);
+        i += run;
+    }
+}
+
+static bool DecompressRLE(const uint8_t *data, size_t size, std::vector<uint8_t> &out) {
+    if(size % 2 != 0) return false;
+
+    size_t outSize = 0;
+    for(size_t i = 1; i < size; i += 2)
+        outSize += data[i];
+
+    out.reserve(outSize);
+
+    for(size_t i = 0; i < size; i += 2)
+        out.insert(out.end(), data[i + 1], data[i]);
+
+    return true;
+}
+
+// LZ77 (LZ4 block format)
+static void WriteSequence(std::vector<uint8_t> &out, const uint8_t *literals, size_t literalCount, size_t offset, size_t matchLength) {
+    const size_t matchCode = (matchLength > 0) ? (matchLength - LZ_MIN_MATCH) : 0;
+
+    out.push_back((std::min<size_t>(literalCount, 15) << 4) | std::min<size_t>(matchCode, 15));
+    if(literalCount >= 15) WriteLength(out, literalCount - 15);
+
+    out.insert(out.end(), literals, literals + literalCount);
+
+    if(matchLength == 0) return; // Final literals.
+
+    out.push_back(offset & 0xFF);
+    out.push_back((offset >> 8) & 0xFF);
+    if(matchCode >= 15) WriteLength(out, matchCode - 15);
+}
+
+static void CompressLZ77(const uint8_t *src, size_t size, std::vector<uint8_t> &out) {
+    std::vector<uint32_t> table(1 << LZ_HASH_BITS, 0); // Position + 1 of each hash's last sighting.
+
+    auto hash = [](uint32_t v) { return (v * 2654435761u) >> (32 - LZ_HASH_BITS); };
+    auto read32 = [src](size_t i) { uint32_t v; std::memcpy(&v, src + i, 4); return v; };
+
+    size_t anchor = 0;
+    size_t i = 0;
+
+    while((size >= LZ_MATCH_LIMIT) && (i + LZ_MATCH_LIMIT <= size)) {
+        const uint32_t sequence = read32(i);
+        const uint32_t h = hash(sequence);
+        const size_t candidate = table[h];
+        table[h] = i + 1;
+
+        if((candidate == 0) || (i - (candidate - 1) > LZ_MAX_OFFSET) || (read32(candidate - 1) != sequence)) {
+            i += 1 + ((i - anchor) >> 6); // Skip faster through incompressible data.
+            continue;
+        }
+
+        size_t matchStart = i;
+        size_t matchFrom = candidate - 1;
+
+        // Extend backwards into the pending literals...
+        while((matchStart > anchor) && (matchFrom > 0) && (src[matchStart - 1] == src[matchFrom - 1])) {
+            matchStart--;
+            matchFrom--;
+        }
+
+        // ...and forwards, short of the final literals.
+        size_t matchLength = (i - matchStart) + LZ_MIN_MATCH;
+        const size_t matchEnd = size - LZ_LAST_LITERALS;
+
+        while((matchStart + matchLength < matchEnd) && (src[matchStart + matchLength] == src[matchFrom + matchLength]))
+            matchLength++;
+
+        WriteSequence(out, src + anchor, matchStart - anchor, matchStart - matchFrom, matchLength);
+
+        i = anchor = matchStart + matchLength;
+    }
+
+    WriteSequence(out, src + anchor, size - anchor, 0, 0);
+}
+
+static bool DecompressLZ77(const uint8_t *p, const uint8_t *end, std::vector<uint8_t> &out, size_t outSize) {
+    // The size prefix is untrusted; don't allocate more than the payload could make.
+    if(outSize > (size_t)(end - p) * LZ_MAX_RATIO) return false;
+
+    out.resize(outSize);
+    uint8_t *dst = out.data();
+    size_t written = 0;
+
+    while(p < end) {
+        const uint8_t token = *p++;
+
+        // Literals
+        size_t literalCount = token >> 4;
+        if((literalCount == 15) && !ReadLength(p, end, literalCount)) return false;
+
+        if(((size_t)(end - p) < literalCount) || (literalCount > outSize - written)) return false;
+        if(literalCount > 0) std::memcpy(dst + written, p, literalCount);
+        written += literalCount;
+        p += literalCount;
+
+        if(p == end) break; // Final literals.
+
+        // Match
+        if((end - p) < 2) return false;
+        const size_t offset = p[0] | (p[1] << 8);
+        p += 2;
+
+        size_t matchLength = token & 0x0F;
+        if((matchLength == 15) && !ReadLength(p, end, matchLength)) return false;
+        matchLength += LZ_MIN_MATCH;
+
+        if((offset == 0) || (offset > written) || (matchLength > outSize - written)) return false;
+
+        // Matches may overlap what they produce; copy those byte by byte.
+        const uint8_t *from = dst + written - offset;
+        if(offset >= matchLength) {
+            std::memcpy(dst + written, from, matchLength);
+        }else {
+            for(size_t n = 0; n < matchLength; n++)
+                dst[written + n] = from[n];
+        }
+
+        written += matchLength;
+    }
+
+    return written == outSize;
+}
+
+// DEFLATE (through raylib)
+static bool CompressDeflate(const uint8_t *data, size_t size, std::vector<uint8_t> &out) {
+    if(size > GALAMAKE_DEFLATE_MAX_SIZE) return false;
+
+    int compSize = 0;
+    unsigned char *compData = CompressData(data, size, &compSize);
+    if(!compData) return false;
+
+    out.insert(out.end(), compData, compData + compSize);
+    MemFree(compData);
+
+    return compSize > 0;
+}
+
+static bool DecompressDeflate(const uint8_t *data, size_t size, std::vector<uint8_t> &out, size_t outSize) {
+    if(outSize > GALAMAKE_DEFLATE_MAX_SIZE) return false;
+
+    int dataSize = 0;
+    unsigned char *decompData = DecompressData(data, size, &dataSize);
+    if(!decompData) return false;
+
+    out.assign(decompData, decompData + dataSize);
+    MemFree(decompData);
+
+    return out.size() == outSize;
+}
+
+bool CompressBytes(const uint8_t *data, size_t size, Compression compression, std::vector<uint8_t> &out) {
+    out.clear();
+    if(size > UINT32_MAX) return false;
+
+    switch(compression) {
+        case Compression::None:
+            out.assign(data, data + size);
+            return true;
+            break;
+
+        case Compression::RLE:
+            CompressRLE(data, size, out);
+            return true;
+            break;
+
+        case Compression::LZ77:
+            WriteUint32LE(out, size);
+            CompressLZ77(data, size, out);
+            return true;
+            break;
+
+        case Compression::Deflate:
+            WriteUint32LE(out, size);
+            return CompressDeflate(data, size, out);
+            break;
+
+        default:
+            return false;
+            break;
+    }
+}
+
+bool DecompressBytes(const uint8_t *data, size_t size, Compression compression, std::vector<uint8_t> &out) {
+    out.clear();
+
+    switch(compression) {
+        case Compression::None:
+            out.assign(data, data + size);
+            return true;
+            break;
+
+        case Compression::RLE:
+            return DecompressRLE(data, size, out);
+            break;
+
+        case Compression::LZ77:
+            if(size < LZ_SIZE_PREFIX) return false;
+            return DecompressLZ77(data + LZ_SIZE_PREFIX, data + size, out, ReadUint32LE(data));
+            break;
+
+        case Compression::Deflate:
+            if(size < LZ_SIZE_PREFIX) return false;
+            return DecompressDeflate(data + LZ_SIZE_PREFIX, size - LZ_SIZE_PREFIX, out, ReadUint32LE(data));
+            break;
+
+        default:
+            return false;
+            break;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,262 @@
+#include <GalaMake/FontBaking.hpp>
+#include <GalaMake/TrueType.hpp>
+#include <GalaMake/QOI.hpp>
+#include <GalaMake/Tracing.hpp>
+#include <GalaMake/Jobs.hpp>
+
+#include <cmath>
+
+std::vector<int> GetFontCodepoints(const json &fontConfig) {
+    std::vector<int> codepoints;
+
+    if(fontConfig.contains("codepoints")) {
+        for(auto &entry : fontConfig["codepoints"]) {
+            if(entry.is_array()) {
+                for(int c = entry[0].get<int>(); c <= entry[1].get<int>(); c++)
+                    codepoints.push_back(c);
+            }else {
+                codepoints.push_back(entry.get<int>());
+            }
+        }
+    }
+
+    if(codepoints.empty()) {
+        for(int c = 32; c < 127; c++)
+            codepoints.push_back(c);
+    }
+
+    std::sort(codepoints.begin(), codepoints.end());
+    codepoints.erase(std::unique(codepoints.begin(), codepoints.end()), codepoints.end());
+
+    return codepoints;
+}
+
+bool AddTextCodepoints(const std::string &path, std::vector<int> &codepoints) {
+    std::ifstream f(path, std::ios::binary);
+    if(!f.good()) return false;
+
+    const std::string text(
+        (std::istreambuf_iterator<char>(f)),
+        std::istreambuf_iterator<char>()
+    );
+    f.close();
+
+    std::vector<bool> seen(0x110000, false);
+    for(int c : codepoints) seen[c] = true;
+
+    const size_t count = codepoints.size();
+
+    for(size_t i = 0; i < text.size();) {
+        const uint8_t lead = text[i];
+
+        int length = 1, codepoint = lead;
+        if(lead >= 0xF0)      { length = 4; codepoint = lead & 0x07; }
+        else if(lead >= 0xE0) { length = 3; codepoint = lead & 0x0F; }
+        else if(lead >= 0xC0) { length = 2; codepoint = lead & 0x1F; }
+        else if(lead >= 0x80) { i++; continue; }
+
+        if((lead >= 0xF8) || (i + length > text.size())) { i++; continue; }
+
+        bool valid = true;
+        for(int j = 1; j < length; j++) {
+            const uint8_t next = text[i + j];
+            if((next & 0xC0) != 0x80) { valid = false; break; }
+
+            codepoint = (codepoint << 6) | (next & 0x3F);
+        }
+
+        if(!valid) { i++; continue; }
+        i += length;
+
+        // Overlong forms, surrogates and the byte order mark aren't characters.
+        static const int minimums[] = {0, 0, 0x80, 0x800, 0x10000};
+        if((codepoint < minimums[length]) || (codepoint > 0x10FFFF)) continue;
+        if(((codepoint >= 0xD800) && (codepoint <= 0xDFFF)) || (codepoint == 0xFEFF)) continue;
+        if((codepoint < 0x20) || ((codepoint >= 0x7F) && (codepoint < 0xA0))) continue;
+
+        if(!seen[codepoint]) {
+            seen[codepoint] = true;
+            codepoints.push_back(codepoint);
+        }
+    }
+
+    if(codepoints.size() != count)
+        std::sort(codepoints.begin(), codepoints.end());
+
+    return true;
+}
+
+std::vector<int> GetFontSizes(const json &fontConfig) {
+    if(fontConfig.contains("sizes"))
+        return fontConfig["sizes"].get<std::vector<int>>();
+
+    if(fontConfig.value("sdf", false))
+        return {GALAMAKE_FONT_SDF_SIZE};
+
+    return {};
+}
+
+bool BakeFont(const std::vector<uint8_t> &fontData, int size, const std::vector<int> &codepoints, bool sdf, JobPool *pool, BakedFont &baked) {
+    baked = BakedFont {};
+    baked.size = size;
+    baked.sdf = sdf;
+
+    // SDF glyphs come with their own padding (the distance field's falloff).
+    baked.glyphPadding = sdf ? 0 : GALAMAKE_FONT_GLYPH_PADDING;
+
+    TrueTypeFont font;
+    if(!font.Open(fontData.data(), fontData.size())) return false;
+
+    // Only codepoints the font actually has.
+    std::vector<int> present;
+    std::vector<int> glyphIndices;
+
+    for(int c : codepoints) {
+        const int glyph = font.GetGlyphIndex(c);
+        if(glyph == 0) continue;
+
+        present.push_back(c);
+        glyphIndices.push_back(glyph);
+    }
+
+    if(present.empty()) return false;
+
+    // Rasterise, a chunk of glyphs per job
+    const size_t chunkCount = (present.size() + GALAMAKE_FONT_BAKE_CHUNK - 1) / GALAMAKE_FONT_BAKE_CHUNK;
+    std::vector<GlyphInfo *> chunks(chunkCount, nullptr);
+
+    {
+        TraceSpan span("rasterise");
+        std::vector<std::function<void()>> jobs;
+
+        for(size_t c = 0; c < chunkCount; c++) {
+            jobs.push_back([&, c] {
+                const size_t first = c * GALAMAKE_FONT_BAKE_CHUNK;
+                const size_t count = std::min<size_t>(GALAMAKE_FONT_BAKE_CHUNK, present.size() - first);
+
+                chunks[c] = LoadFontData(fontData.data(), fontData.size(), size, present.data() + first, count, sdf ? FONT_SDF : FONT_DEFAULT);
+            });
+        }
+
+        if(pool) {
+            pool->RunBatch(std::move(jobs));
+        }else {
+            for(auto &job : jobs) job();
+        }
+    }
+
+    auto unloadChunks = [&] {
+        for(size_t c = 0; c < chunkCount; c++) {
+            const size_t count = std::min<size_t>(GALAMAKE_FONT_BAKE_CHUNK, present.size() - c * GALAMAKE_FONT_BAKE_CHUNK);
+            if(chunks[c]) UnloadFontData(chunks[c], count);
+        }
+    };
+
+    std::vector<GlyphInfo> glyphs;
+
+    for(size_t c = 0; c < chunkCount; c++) {
+        if(!chunks[c]) { unloadChunks(); return false; }
+
+        const size_t count = std::min<size_t>(GALAMAKE_FONT_BAKE_CHUNK, present.size() - c * GALAMAKE_FONT_BAKE_CHUNK);
+        glyphs.insert(glyphs.end(), chunks[c], chunks[c] + count); // Images still belong to the chunks.
+    }
+
+    // Pack
+    Rectangle *recs = nullptr;
+    Image atlas;
+    {
+        TraceSpan span("pack");
+        atlas = GenImageFontAtlas(glyphs.data(), &recs, glyphs.size(), size, baked.glyphPadding, 1);
+    }
+
+    if(!atlas.data || !recs) {
+        unloadChunks();
+        UnloadImage(atlas);
+        MemFree(recs);
+        return false;
+    }
+
+    for(size_t i = 0; i < glyphs.size(); i++) {
+        baked.glyphs.push_back({
+            glyphs[i].value,
+            (int)recs[i].x, (int)recs[i].y, (int)recs[i].width, (int)recs[i].height,
+            glyphs[i].offsetX, glyphs[i].offsetY, glyphs[i].advanceX
+        });
+    }
+
+    {
+        TraceSpan span("encode");
+        baked.atlasData = EncodeQOI(atlas);
+    }
+
+    unloadChunks();
+    UnloadImage(atlas);
+    MemFree(recs);
+
+    if(baked.atlasData.empty()) return false;
+
+    // Kerning, scaled as the glyphs were.
+    if(font.HasKerning()) {
+        TraceSpan span("kerning");
+        const float scale = font.GetScaleForPixelHeight(size);
+
+        // Codepoints by glyph (several may share one).
+        std::map<int, std::vector<int>> glyphCodepoints;
+        for(size_t i = 0; i < present.size(); i++)
+            glyphCodepoints[glyphIndices[i]].push_back(present[i]);
+
+        for(auto &[key, units] : font.GetKerningPairs(glyphIndices)) {
+            const int amount = std::lround(units * scale);
+            if(amount == 0) continue;
+
+            for(int first : glyphCodepoints[key >> 16])
+                for(int second : glyphCodepoints[key & 0xFFFF])
+                    baked.kerning.push_back({first, second, amount});
+        }
+
+        std::sort(baked.kerning.begin(), baked.kerning.end(), [](const KerningPair &a, const KerningPair &b) {
+            return (a.first != b.first) ? (a.first < b.first) : (a.second < b.second);
+        });
+    }
+
+    return true;
+}
+
+static inline void WriteLE(uint8_t *out, int32_t value, size_t bytes) {
+    for(size_t i = 0; i < bytes; i++)
+        out[i] = ((uint32_t)value >> (i * 8)) & 0xFF;
+}
+
+std::vector<uint8_t> GetGlyphTableBytes(const std::vector<BakedGlyph> &glyphs) {
+    auto bytes = std::vector<uint8_t>(glyphs.size() * GALAMAKE_FONT_GLYPH_SIZE, 0x00);
+
+    for(size_t i = 0; i < glyphs.size(); i++) {
+        uint8_t *record = bytes.data() + i * GALAMAKE_FONT_GLYPH_SIZE;
+        const BakedGlyph &g = glyphs[i];
+
+        WriteLE(record + 0, g.codepoint, 4);
+        WriteLE(record + 4, g.x, 2);
+        WriteLE(record + 6, g.y, 2);
+        WriteLE(record + 8, g.width, 2);
+        WriteLE(record + 10, g.height, 2);
+        WriteLE(record + 12, g.offsetX, 2);
+        WriteLE(record + 14, g.offsetY, 2);
+        WriteLE(record + 16, g.advanceX, 2);
+    }
+
+    return bytes;
+}
+
+std::vector<uint8_t> GetKerningTableBytes(const std::vector<KerningPair> &kerning) {
+    auto bytes = std::vector<uint8_t>(kerning.size() * GALAMAKE_FONT_KERNING_SIZE, 0x00);
+
+    for(size_t i = 0; i < kerning.size(); i++) {
+        uint8_t *record = bytes.data() + i * GALAMAKE_FONT_KERNING_SIZE;
+
+        WriteLE(record + 0, kerning[i].first, 4);
+        WriteLE(record + 4, kerning[i].second, 4);
+        WriteLE(record + 8, kerning[i].amount, 2);
+    }
+
+    return bytes;
+}
\ No newline at end of file
@@ -0,0 +1,328 @@
+#include <GalaMake/GresTable.hpp>
+#include <GalaMake/Tracing.hpp>
+#include <GalaMake/Writing.hpp>
+#include <GalaMake/Compression.hpp>
+
+// General item stuff
+xdt::Item &GresTable::FindOrAddItem(const std::string &itemName, bool &added) {
+    const auto [it, inserted] = index.try_emplace(itemName, directory.size());
+    added = inserted;
+
+    if(inserted)
+        directory.emplace_back(itemName, xdt::Item {});
+
+    return directory[it->second].second;
+}
+
+xdt::Item *GresTable::GetItem(const std::string &itemName) {
+    const auto it = index.find(itemName);
+    if(it == index.end()) return nullptr;
+
+    return &directory[it->second].second;
+}
+
+bool GresTable::ItemExists(const std::string &itemName) const {
+    return index.count(itemName) > 0;
+}
+
+xdt::ItemType GresTable::GetItemType(const std::string &itemName) const {
+    const auto it = index.find(itemName);
+    if(it == index.end()) return xdt::ItemType::Byte;
+
+    return directory[it->second].second.type;
+}
+
+void GresTable::DeleteItem(const std::string &itemName) {
+    const auto it = index.find(itemName);
+    if(it == index.end()) return;
+
+    const size_t position = it->second;
+    directory.erase(directory.begin() + position);
+    index.erase(it);
+    externalBlobs.erase(itemName);
+
+    // Everything after the removed item moves up by one.
+    for(size_t i = position; i < directory.size(); i++)
+        index[directory[i].first] = i;
+}
+
+size_t GresTable::GetItemCount() const {
+    return directory.size();
+}
+
+const std::vector<std::pair<std::string, xdt::Item>> &GresTable::GetDirectory() const {
+    return directory;
+}
+
+// A referenced blob is dropped once its item holds any other type of value.
+void GresTable::ReleaseExternalBlob(const std::string &itemName, const xdt::Item &item) {
+    if((item.type == xdt::ItemType::File) || (item.type == xdt::ItemType::Raw)) return;
+
+    externalBlobs.erase(itemName);
+}
+
+// Setters
+// New items always take the type of their first value.
+void GresTable::SetByte(const std::string &itemName, uint8_t value, bool overwriteType) {
+    bool added = false;
+    xdt::Item &item = FindOrAddItem(itemName, added);
+    item.SetByte(value, overwriteType || added);
+    ReleaseExternalBlob(itemName, item);
+}
+
+void GresTable::SetBool(const std::string &itemName, bool value, bool overwriteType) {
+    bool added = false;
+    xdt::Item &item = FindOrAddItem(itemName, added);
+    item.SetBool(value, overwriteType || added);
+    ReleaseExternalBlob(itemName, item);
+}
+
+void GresTable::SetInt16(const std::string &itemName, int16_t value, bool overwriteType) {
+    bool added = false;
+    xdt::Item &item = FindOrAddItem(itemName, added);
+    item.SetInt16(value, overwriteType || added);
+    ReleaseExternalBlob(itemName, item);
+}
+
+void GresTable::SetUint16(const std::string &itemName, uint16_t value, bool overwriteType) {
+    bool added = false;
+    xdt::Item &item = FindOrAddItem(itemName, added);
+    item.SetUint16(value, overwriteType || added);
+    ReleaseExternalBlob(itemName, item);
+}
+
+void GresTable::SetInt32(const std::string &itemName, int32_t value, bool overwriteType) {
+    bool added = false;
+    xdt::Item &item = FindOrAddItem(itemName, added);
+    item.SetInt32(value, overwriteType || added);
+    ReleaseExternalBlob(itemName, item);
+}
+
+void GresTable::SetUint32(const std::string &itemName, uint32_t value, bool overwriteType) {
+    bool added = false;
+    xdt::Item &item = FindOrAddItem(itemName, added);
+    item.SetUint32(value, overwriteType || added);
+    ReleaseExternalBlob(itemName, item);
+}
+
+void GresTable::SetInt64(const std::string &itemName, int64_t value, bool overwriteType) {
+    bool added = false;
+    xdt::Item &item = FindOrAddItem(itemName, added);
+    item.SetInt64(value, overwriteType || added);
+    ReleaseExternalBlob(itemName, item);
+}
+
+void GresTable::SetUint64(const std::string &itemName, uint64_t value, bool overwriteType) {
+    bool added = false;
+    xdt::Item &item = FindOrAddItem(itemName, added);
+    item.SetUint64(value, overwriteType || added);
+    ReleaseExternalBlob(itemName, item);
+}
+
+void GresTable::SetFloat(const std::string &itemName, float value, bool overwriteType) {
+    bool added = false;
+    xdt::Item &item = FindOrAddItem(itemName, added);
+    item.SetFloat(value, overwriteType || added);
+    ReleaseExternalBlob(itemName, item);
+}
+
+void GresTable::SetDouble(const std::string &itemName, double value, bool overwriteType) {
+    bool added = false;
+    xdt::Item &item = FindOrAddItem(itemName, added);
+    item.SetDouble(value, overwriteType || added);
+    ReleaseExternalBlob(itemName, item);
+}
+
+void GresTable::SetString(const std::string &itemName, const std::string &value, bool isUTF8, bool overwriteType) {
+    bool added = false;
+    xdt::Item &item = FindOrAddItem(itemName, added);
+    item.SetString(value, isUTF8, overwriteType || added);
+    ReleaseExternalBlob(itemName, item);
+}
+
+void GresTable::SetBytes(const std::string &itemName, const std::vector<uint8_t> &value, bool isFileData, bool overwriteType) {
+    bool added = false;
+    xdt::Item &item = FindOrAddItem(itemName, added);
+    if(!CanSetBytes(item, isFileData, overwriteType || added)) return;
+
+    item.SetBytes(value, isFileData, true);
+    externalBlobs.erase(itemName);
+}
+
+// Same rule as xdt::Item::SetBytes: bytes only replace bytes of the same kind,
+// unless overwriting the type.
+bool GresTable::CanSetBytes(const xdt::Item &item, bool isFileData, bool overwriteType) const {
+    const xdt::ItemType type = isFileData ? xdt::ItemType::File : xdt::ItemType::Raw;
+
+    return overwriteType || (item.type == type);
+}
+
+void GresTable::SetBytes(const std::string &itemName, std::vector<uint8_t> &&value, bool isFileData, bool overwriteType) {
+    bool added = false;
+    xdt::Item &item = FindOrAddItem(itemName, added);
+    if(!CanSetBytes(item, isFileData, overwriteType || added)) return;
+
+    item.type = isFileData ? xdt::ItemType::File : xdt::ItemType::Raw;
+    item.data = std::move(value);
+    externalBlobs.erase(itemName);
+}
+
+void GresTable::SetBytes(const std::string &itemName, const uint8_t *data, size_t size, bool isFileData, bool overwriteType) {
+    bool added = false;
+    xdt::Item &item = FindOrAddItem(itemName, added);
+    if(!CanSetBytes(item, isFileData, overwriteType || added)) return;
+
+    item.type = isFileData ? xdt::ItemType::File : xdt::ItemType::Raw;
+    item.data.clear();
+    item.data.shrink_to_fit();
+
+    externalBlobs[itemName] = ExternalBlob {data, size, ""};
+}
+
+bool GresTable::SetBytesFromFile(const std::string &itemName, const std::string &path, bool isFileData, bool overwriteType) {
+    std::error_code ec;
+    const uintmax_t size = std::filesystem::file_size(path, ec);
+    if(ec) return false;
+
+    bool added = false;
+    xdt::Item &item = FindOrAddItem(itemName, added);
+    if(!CanSetBytes(item, isFileData, overwriteType || added)) return false;
+
+    item.type = isFileData ? xdt::ItemType::File : xdt::ItemType::Raw;
+    item.data.clear();
+    item.data.shrink_to_fit();
+
+    externalBlobs[itemName] = ExternalBlob {nullptr, (size_t)size, path};
+
+    return true;
+}
+
+static inline bool IsBLOBType(xdt::ItemType type) {
+    return std::find(xdt::BLOBTypes.begin(), xdt::BLOBTypes.end(), type) != xdt::BLOBTypes.end();
+}
+
+// Compression
+void GresTable::SetCompression(Compression compression, size_t minSize) {
+    for(auto &[name, item] : directory) {
+        if(!IsBLOBType(item.type)) continue;
+
+        const auto external = externalBlobs.find(name);
+        const size_t size = (external != externalBlobs.end()) ? external->second.size : item.data.size();
+
+        SetItemCompression(item.flags, (size >= minSize) ? compression : Compression::None);
+    }
+}
+
+// Compresses a blob, failing if that doesn't make it any smaller.
+static bool CompressBlob(const uint8_t *data, size_t size, const std::string &path, Compression compression, std::vector<uint8_t> &out) {
+    std::vector<uint8_t> fileData;
+
+    if(!path.empty()) {
+        std::ifstream f(path, std::ios::binary);
+        fileData.resize(size);
+        if(!f.read((char *)fileData.data(), size)) return false;
+
+        data = fileData.data();
+    }
+
+    if(!CompressBytes(data, size, compression, out)) return false;
+
+    return out.size() < size;
+}
+
+// File IO
+static void WriteUint16LE(std::vector<uint8_t> &out, uint16_t value) {
+    out.push_back(value & 0xFF);
+    out.push_back((value >> 8) & 0xFF);
+}
+
+static void WriteUint32LE(std::vector<uint8_t> &out, uint32_t value) {
+    for(int i = 0; i < 4; i++)
+        out.push_back((value >> (i * 8)) & 0xFF);
+}
+
+// Writes the same bytes as xdt::Table::Save (plus any compression). The header
+// and directory are laid out first (every blob's size is known up front), then
+// each blob is written from wherever it already is.
+bool GresTable::Save(const std::string &filename) {
+    std::vector<ExternalBlob> blobs;
+    std::vector<std::vector<uint8_t>> compressedData;
+    std::vector<uint8_t> head;
+
+    {
+        TraceSpan span("serialise");
+
+        // Header
+        for(int i = 3; i >= 0; i--)
+            head.push_back((XDT_MAGIC >> (i * 8)) & 0xFF);
+
+        head.push_back((headerInfo.version >> 8) & 0xFF);
+        head.push_back(headerInfo.version & 0xFF);
+        head.push_back(headerInfo.flags.low);
+        head.push_back(headerInfo.flags.high);
+        WriteUint16LE(head, directory.size());
+
+        // Directory
+        compressedData.reserve(directory.size()); // blobs points into these.
+
+        for(auto &[name, item] : directory) {
+            const bool isBLOB = IsBLOBType(item.type);
+            xdt::ItemFlags flags = item.flags;
+
+            const auto external = externalBlobs.find(name);
+            ExternalBlob blob = (external != externalBlobs.end()) ?
+                external->second :
+                ExternalBlob {item.data.data(), item.data.size(), ""};
+
+            // Compressed items that don't shrink are stored as they are.
+            const Compression compression = GetItemCompression(flags);
+
+            if(isBLOB && (compression != Compression::None)) {
+                TraceSpan compressSpan("compress");
+                std::vector<uint8_t> &compressed = compressedData.emplace_back();
+
+                if(CompressBlob(blob.data, blob.size, blob.path, compression, compressed)) {
+                    blob = ExternalBlob {compressed.data(), compressed.size(), ""};
+                }else {
+                    SetItemCompression(flags, Compression::None);
+                }
+            }
+
+            head.push_back(name.size());
+            head.insert(head.end(), name.begin(), name.end());
+            head.push_back((uint8_t)item.type);
+
+            if(isBLOB) {
+                if(blob.size > UINT32_MAX) return false; // Beyond what XDT can address.
+
+                WriteUint32LE(head, blob.size);
+                blobs.push_back(blob);
+            }else {
+                for(size_t i = 0; i < 4; i++)
+                    head.push_back((i < blob.size) ? blob.data[i] : 0x00);
+            }
+
+            head.push_back(flags.low);
+            head.push_back(flags.high);
+        }
+    }
+
+    {
+        TraceSpan span("write");
+        FileWriter writer;
+        if(!writer.Open(filename)) return false;
+
+        writer.Write(head.data(), head.size());
+
+        for(auto &blob : blobs) {
+            if(blob.path.empty()) writer.Write(blob.data, blob.size);
+            else                  writer.WriteFile(blob.path, blob.size);
+        }
+
+        if(!writer.Close()) return false;
+    }
+
+    return true;
+}
+
+GresTable::GresTable() : headerInfo(xdt::Table().headerInfo) {}
\ No newline at end of file
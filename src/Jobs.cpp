@@ -0,0 +1,180 @@
+#include <GalaMake/Jobs.hpp>
+
+static thread_local JobPool *t_currentPool = nullptr;
+static thread_local size_t t_currentQueue = 0;
+
+bool JobPool::PopJob(size_t queueIndex, std::function<void()> &job) {
+    // Own queue first (newest job, still warm in cache)...
+    {
+        WorkerQueue &own = *queues[queueIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+
+        if(!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            return true;
+        }
+    }
+
+    // ...then the oldest job submitted from outside the pool...
+    {
+        std::lock_guard<std::mutex> lock(sharedQueue.mutex);
+
+        if(!sharedQueue.jobs.empty()) {
+            job = std::move(sharedQueue.jobs.front());
+            sharedQueue.jobs.pop_front();
+            return true;
+        }
+    }
+
+    // ...then steal the oldest job from another worker.
+    for(size_t i = 1; i < queues.size(); i++) {
+        WorkerQueue &victim = *queues[(queueIndex + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if(!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void JobPool::WorkerLoop(size_t queueIndex) {
+    t_currentPool = this;
+    t_currentQueue = queueIndex;
+
+    while(true) {
+        // Claim a job (or leave, once stopping and out of work).
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            wakeCondition.wait(lock, [this] { return stopping || (queuedJobs > 0); });
+
+            if(queuedJobs == 0) return;
+            queuedJobs--;
+        }
+
+        // A claimed job is always in some queue, though another worker may
+        // briefly hold the lock on it.
+        std::function<void()> job;
+        while(!PopJob(queueIndex, job))
+            std::this_thread::yield();
+
+        job();
+
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            pendingJobs--;
+            if(pendingJobs == 0) idleCondition.notify_all();
+        }
+    }
+}
+
+void JobPool::Submit(std::function<void()> job) {
+    std::unique_lock<std::mutex> stateLock(stateMutex);
+
+    // Jobs spawned from a worker stay local; others keep submission order.
+    WorkerQueue &queue = (t_currentPool == this) ? *queues[t_currentQueue] : sharedQueue;
+
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+
+    queuedJobs++;
+    pendingJobs++;
+    stateLock.unlock();
+
+    wakeCondition.notify_one();
+}
+
+// Runs the newest job in the calling worker's own queue, if there is one.
+bool JobPool::RunOwnJob() {
+    if(t_currentPool != this) return false;
+
+    std::function<void()> job;
+    {
+        std::lock_guard<std::mutex> stateLock(stateMutex);
+        if(queuedJobs == 0) return false;
+
+        WorkerQueue &own = *queues[t_currentQueue];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if(own.jobs.empty()) return false;
+
+        // Taken with both locks held, so workers which already claimed a
+        // job still find one.
+        queuedJobs--;
+        job = std::move(own.jobs.back());
+        own.jobs.pop_back();
+    }
+
+    job();
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        pendingJobs--;
+        if(pendingJobs == 0) idleCondition.notify_all();
+    }
+
+    return true;
+}
+
+void JobPool::RunBatch(std::vector<std::function<void()>> jobs) {
+    std::mutex batchMutex;
+    std::condition_variable batchCondition;
+    size_t remaining = jobs.size();
+
+    for(auto &job : jobs) {
+        Submit([&, job = std::move(job)] {
+            job();
+
+            std::lock_guard<std::mutex> lock(batchMutex);
+            if(--remaining == 0) batchCondition.notify_all();
+        });
+    }
+
+    // Workers help with their own share; anything left is already running.
+    while(RunOwnJob()) {}
+
+    std::unique_lock<std::mutex> lock(batchMutex);
+    batchCondition.wait(lock, [&] { return remaining == 0; });
+}
+
+void JobPool::Wait() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    idleCondition.wait(lock, [this] { return pendingJobs == 0; });
+}
+
+size_t JobPool::GetWorkerCount() const {
+    return threads.size();
+}
+
+JobPool::JobPool(size_t workerCount) {
+    if(workerCount == 0) workerCount = GetDefaultJobCount();
+
+    for(size_t i = 0; i < workerCount; i++)
+        queues.push_back(std::make_unique<WorkerQueue>());
+
+    for(size_t i = 0; i < workerCount; i++)
+        threads.emplace_back(&JobPool::WorkerLoop, this, i);
+}
+
+JobPool::~JobPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+
+    wakeCondition.notify_all();
+
+    for(auto &t : threads)
+        t.join();
+}
+
+size_t GetDefaultJobCount() {
+    const size_t cores = std::thread::hardware_concurrency();
+
+    return (cores > 0) ? cores : 1;
+}
\ No newline at end of file
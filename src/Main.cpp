@@ -4,6 +4,13 @@
 #include <GalaMake/Utils.hpp>
 #include <GalaMake/Checking.hpp>
 #include <GalaMake/Fixing.hpp>
+#include <GalaMake/Jobs.hpp>
+#include <GalaMake/Caching.hpp>
+#include <GalaMake/Tracing.hpp>
+#include <GalaMake/Packing.hpp>
+#include <GalaMake/Watching.hpp>
+#include <GalaMake/MappedTable.hpp>
+#include <GalaMake/Benchmark.hpp>
 
 void PrintError(const ToolError error, const std::vector<std::string> &args = {}) {
     std::cerr << "\e[1;31merror: \e[0m";
@@ -52,6 +59,26 @@ void PrintError(const ToolError error, const std::vector<std::string> &args = {}
             }
             break;
 
+        case ToolError::InvalidOption:
+            if(args.size() >= 1) {
+                std::cerr << "invalid option value: \"" << args[0] << "\"." << std::endl;
+            }else {
+                std::cerr << "invalid option value." << std::endl;
+            }
+            break;
+
+        case ToolError::ResourceNotBuilt:
+            if(args.size() >= 1) {
+                std::cerr << "resource not built: \"" << args[0] << "\".\ntry 'galamake buildall' first." << std::endl;
+            }else {
+                std::cerr << "resource not built.\ntry 'galamake buildall' first." << std::endl;
+            }
+            break;
+
+        case ToolError::WatchUnavailable:
+            std::cerr << "could not watch the workspace for changes (unsupported platform, or no asset directories).\ntry 'galamake repair' to create missing directories." << std::endl;
+            break;
+
         default:
             std::cerr << "UNKNOWN ERROR. THIS IS A BUG." << std::endl;
             break;
@@ -65,9 +92,13 @@ void PrintError(ToolError error, const std::string &arg) {
     PrintError(error, args);
 }
 
+void PrintWarning(const std::string &message) {
+    std::cerr << "\e[1;33mwarning: \e[0m" << message << std::endl;
+}
+
 void PrintVersion() {
     std::cout
-        << "GalaMake v1.0.0 - January, 2023\n"
+        << "GalaMake v" GALAMAKE_VERSION " - January, 2023\n"
         << "by Colleen (@colleen05), and GitHub contributors.\n"
         << "\n"
         << "This software is distributed under the zlib license.\n"
@@ -85,7 +116,15 @@ void PrintHelp() {
         << "        --default or -d     Skips config setup wizard; creates default config file.\n"
         << "\n"
         << "    build <resource-uri>    Builds resource file of specified resource.\n"
-        << "    buildall                Builds project using settings in '" GALAMAKE_CONFIG_NAME "'.\n"
+        << "    buildall [args...]      Builds project using settings in '" GALAMAKE_CONFIG_NAME "'.\n"
+        << "        --jobs or -j <n>    Builds up to <n> resources at once (0 = one per CPU core).\n"
+        << "        --pack              Packs resources after building (see 'pack').\n"
+        << "        --atlas             Packs sprite and nslice textures into shared atlas pages ('build_options.atlas_size').\n"
+        << "    pack                    Packs built resources into one archive ('build_options.pack_file').\n"
+        << "    watch [args...]         Watches the workspace and rebuilds resources as they change.\n"
+        << "        --jobs or -j <n>    Builds up to <n> resources at once (0 = one per CPU core).\n"
+        << "    info <resource-uri>     Lists the items in a built resource file.\n"
+        << "    benchmark <what>        Benchmarks codecs on built resources. <what>: 'compression' or 'qoi'.\n"
         << "    scan                    Scans and lists each valid resource.\n"
         << "    report                  Scans for and lists missing directories and broken resources.\n"
         << "    repair                  Scans for and repairs broken resources and workspace structure.\n"
@@ -93,6 +132,8 @@ void PrintHelp() {
         << "Options:\n"
         << "    --version or -v     Display version information.\n"
         << "    --help    or -h     Display this help information.\n"
+        << "    --deep-verify       Fully decode sounds to verify them, not just their headers.\n"
+        << "    --trace <file>      Write a Chrome trace of build stages to <file> (build, buildall, pack).\n"
         << "\n"
         << "Resource URI: <type>:<name>\n"
         << "\n"
@@ -264,6 +305,15 @@ bool CheckBuildConfig(const json &buildConfig) {
     if(buildConfig["build_options"].count("use_cache") < 1)     return false;
     if(!buildConfig["build_options"]["use_cache"].is_boolean()) return false;
 
+    if(buildConfig["build_options"].contains("pack_file") && !buildConfig["build_options"]["pack_file"].is_string())
+        return false;
+
+    if(buildConfig["build_options"].contains("shared_cache_dir") && !buildConfig["build_options"]["shared_cache_dir"].is_string())
+        return false;
+
+    BuildOptions buildOptions;
+    if(!ReadBuildOptions(buildConfig, buildOptions)) return false;
+
     return true;
 }
 
@@ -333,6 +383,17 @@ bool FixBuildConfig(json &buildConfig, const std::string &path, bool doLog = tru
         tempConfig["build_options"][name] = buildConfig["build_options"][name];
     }
 
+    // Optional build options (checked against the defaults, so only the key itself decides)
+    for(const auto &name : g_optionalBuildOptions) {
+        if(!buildConfig["build_options"].contains(name)) continue;
+
+        json trialConfig = g_defaultBuildConfig;
+        trialConfig["build_options"][name] = buildConfig["build_options"][name];
+
+        if(CheckBuildConfig(trialConfig))
+            tempConfig["build_options"][name] = buildConfig["build_options"][name];
+    }
+
     // Saving
     buildConfig = tempConfig;
 
@@ -343,6 +404,161 @@ bool FixBuildConfig(json &buildConfig, const std::string &path, bool doLog = tru
     return true;
 }
 
+struct BuildStepResult {
+    std::string output;
+    std::string warning; // Printed after the output, if not empty.
+    bool failed = false;
+};
+
+// Checks and builds one resource (unless the cache has it as up to date, or
+// the shared cache has it already built), returning its line of console output.
+BuildStepResult BuildResourceStep(const ResourceInfo &resInfo, BuildCache *cache, const SharedCache *sharedCache, const BuildOptions &options) {
+    const std::string resTypeStr = GetResourceTypeString(resInfo.type);
+    TraceSpan resourceSpan(resTypeStr + ":" + resInfo.name, "resource");
+
+    BuildStepResult result;
+    result.output = "Building " + resTypeStr + " resource: \"" + resInfo.name + "\"... ";
+
+    // Atlased resources depend on the whole atlas layout, not just their own files.
+    const bool atlased = (GetAtlasPlacement(options, resInfo) != nullptr);
+
+    if(cache && !atlased && cache->IsUpToDate(resInfo)) {
+        result.output += "\e[0;32mUP TO DATE\e[0m.";
+        return result;
+    }
+
+    ValidatedResource validated;
+    ResourceCheckError resError = ResourceCheckError::None;
+    {
+        TraceSpan checkSpan("check");
+        resError = CheckResourceIntegrity(resInfo, validated);
+    }
+
+    if(resError != ResourceCheckError::None) {
+        result.output += "\e[1;31m" + GetResourceCheckErrorString(resError, validated.failedField) + "\e[0m.";
+        return result;
+    }
+
+    // Shared cache
+    std::string sharedKey;
+    const bool useShared = sharedCache && sharedCache->IsOpen() && !atlased && sharedCache->GetKey(resInfo, sharedKey);
+
+    if(useShared) {
+        bool fetched = false;
+        {
+            TraceSpan fetchSpan("fetch");
+            fetched = sharedCache->Fetch(sharedKey, resInfo);
+        }
+
+        if(fetched) {
+            if(cache) cache->Update(resInfo);
+
+            result.output += "\e[0;32mFETCHED\e[0m.";
+            return result;
+        }
+    }
+
+    bool success = false;
+    std::string note;
+    try {
+        success = BuildResource(validated, options, &note, &result.warning);
+    } catch(std::exception &e) {
+        success = false;
+    }
+
+    if(success && useShared) {
+        TraceSpan storeSpan("store");
+        sharedCache->Store(sharedKey, resInfo); // Only a missed chance to share if this fails.
+    }
+
+    if(cache) {
+        if(success) cache->Update(resInfo);
+        else        cache->Invalidate(resInfo);
+    }
+
+    result.output += (success ? "\e[0;32mDONE" : "\e[1;31mFAILED");
+    result.output += "\e[0m";
+    if(success && !note.empty()) result.output += " (" + note + ")";
+    result.output += ".";
+    result.failed = !success;
+
+    return result;
+}
+
+bool PackResources(const json &buildConfig) {
+    TraceSpan packSpan("pack");
+
+    std::vector<PackEntry> entries;
+    bool success = true;
+
+    for(auto &resURI : ScanResources(buildConfig)) {
+        const auto [resTypeStr, resName] = SplitResourceURI(resURI);
+
+        if(g_typeStrs.count(resTypeStr) == 0) {
+            PrintError(ToolError::InvalidResourceType, resTypeStr);
+            return false;
+        }
+
+        const ResourcePathInfo resPaths = GenResourcePaths(buildConfig, g_typeStrs[resTypeStr], resName);
+
+        if(!std::filesystem::exists(resPaths.outputPath)) {
+            PrintError(ToolError::ResourceNotBuilt, resURI);
+            success = false;
+            continue;
+        }
+
+        entries.push_back({resTypeStr + ":" + resName, resPaths.outputPath});
+    }
+
+    for(auto &page : ScanAtlasPages(buildConfig))
+        entries.push_back({"atlas:" + page, GetAtlasPagePath(buildConfig, page)});
+
+    if(!success) return false;
+
+    const std::string packPath = GetPackPath(buildConfig);
+    std::cout << "Packing " << entries.size() << " resources into '" << packPath << "'... ";
+
+    success = WritePack(packPath, entries);
+    std::cout << (success ? "\e[0;32mDONE" : "\e[1;31mFAILED") << "\e[0m." << std::endl;
+
+    return success;
+}
+
+bool PopOption(std::vector<std::string> &args, const std::vector<std::string> &names) {
+    bool found = false;
+
+    for(auto &name : names) {
+        auto it = std::find(args.begin(), args.end(), name);
+
+        while(it != args.end()) {
+            found = true;
+            it = std::find(args.erase(it), args.end(), name);
+        }
+    }
+
+    return found;
+}
+
+bool PopOptionValue(std::vector<std::string> &args, const std::vector<std::string> &names, std::string &value) {
+    for(auto &name : names) {
+        auto it = std::find(args.begin(), args.end(), name);
+        if(it == args.end()) continue;
+
+        value.clear();
+
+        if((it + 1) != args.end()) {
+            value = *(it + 1);
+            args.erase(it, it + 2);
+        }else {
+            args.erase(it);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
 void rllog(int logLevel, const char *text, va_list args) {
     return;
 }
@@ -355,6 +571,10 @@ int main(int argc, char **argv) {
     // Args and options
     std::vector<std::string> args(argv + 1, argv + argc);
     bool op_doDefaultConfig = false;
+    size_t op_jobCount = 1;
+    bool op_doPack = false;
+    BuildOptions op_buildOptions;
+    std::string op_traceFile;
 
     if( (args.empty()) ||
         (std::find(args.begin(), args.end(), "--help") != args.end()) ||
@@ -370,12 +590,43 @@ int main(int argc, char **argv) {
         return 0;
     }
 
-    if( (std::find(args.begin(), args.end(), "--default") != args.end()) ||
-        (std::find(args.begin(), args.end(), "-d") != args.end())
-    ) {
+    if(PopOption(args, {"--default", "-d"}))
         op_doDefaultConfig = true;
-        std::remove(args.begin(), args.end(), "--default");
-        std::remove(args.begin(), args.end(), "-d");
+
+    if(PopOption(args, {"--pack"}))
+        op_doPack = true;
+
+    if(PopOption(args, {"--atlas"}))
+        op_buildOptions.atlas = true;
+
+    if(PopOption(args, {"--deep-verify"}))
+        op_buildOptions.deepVerify = true;
+
+    if(PopOptionValue(args, {"--trace"}, op_traceFile)) {
+        if(op_traceFile.empty()) {
+            PrintError(ToolError::InvalidOption, "--trace");
+            return 1;
+        }
+
+        GetTracer().Enable();
+    }
+
+    std::string jobsStr;
+    if(PopOptionValue(args, {"--jobs", "-j"}, jobsStr)) {
+        try {
+            const int jobs = std::stoi(jobsStr);
+            if(jobs < 0) throw std::out_of_range(jobsStr);
+
+            op_jobCount = (jobs == 0) ? GetDefaultJobCount() : jobs;
+        } catch(std::exception &e) {
+            PrintError(ToolError::InvalidOption, "--jobs " + jobsStr);
+            return 1;
+        }
+    }
+
+    if(args.empty()) {
+        PrintError(ToolError::InvalidAction);
+        return 1;
     }
 
 
@@ -408,6 +659,15 @@ int main(int argc, char **argv) {
             PrintError(ToolError::InvalidConfig);
             return 1;
         }
+
+        if(validConfig) ReadBuildOptions(j_buildConfig, op_buildOptions);
+    }
+
+    // Only buildall packs atlas pages; a resource rebuilt on its own would
+    // be built as a standalone texture, leaving a stale copy in its page.
+    if(op_buildOptions.atlas && ((actionStr == "build") || (actionStr == "watch"))) {
+        PrintError(ToolError::InvalidOption, "--atlas (buildall only)");
+        return 1;
     }
 
     if(actionStr == "new") {
@@ -470,26 +730,77 @@ int main(int argc, char **argv) {
         Timer buildTimer;
         buildTimer.Start();
 
-        bool success = BuildResource(ResourceInfo {
+        const auto resInfo = ResourceInfo {
             resType,
             resName,
             resPaths
-        });
+        };
+
+        ValidatedResource validated;
+        ResourceCheckError resError = ResourceCheckError::None;
+        bool success = false;
+        std::string note, warning;
+
+        {
+            TraceSpan resourceSpan(resURI, "resource");
+
+            {
+                TraceSpan checkSpan("check");
+                resError = CheckResourceIntegrity(resInfo, validated);
+            }
+
+            if(resError == ResourceCheckError::None) {
+                JobPool pool; // One thread per core, as a single resource has the machine to itself.
+                op_buildOptions.pool = &pool;
+
+                success = BuildResource(validated, op_buildOptions, &note, &warning);
+                op_buildOptions.pool = nullptr;
+            }
+        }
+
+        if(!op_traceFile.empty()) GetTracer().Save(op_traceFile);
+
+        if(resError != ResourceCheckError::None) {
+            std::cout << ("\e[1;31m" + GetResourceCheckErrorString(resError, validated.failedField) + "\e[0m.") << std::endl;
+            return 1;
+        }
+
+        // Keep the cache in step, so the next buildall doesn't redo this.
+        if(j_buildConfig["build_options"]["use_cache"].get<bool>()) {
+            BuildCache cache;
+            cache.Load(GALAMAKE_CACHE_NAME, GetBuildOptionsKey(op_buildOptions));
+
+            if(success) cache.Update(resInfo);
+            else        cache.Invalidate(resInfo);
+
+            cache.Save(GALAMAKE_CACHE_NAME);
+        }
 
         double secs = buildTimer.Stop();
 
-        std::cout << (success ? "\e[0;32mDONE" : "\e[1;31mFAILED") << "\e[0m." << std::endl;
+        std::cout << (success ? "\e[0;32mDONE" : "\e[1;31mFAILED") << "\e[0m";
+        if(success && !note.empty()) std::cout << " (" << note << ")";
+        std::cout << "." << std::endl;
+
+        if(!warning.empty()) PrintWarning(warning);
 
         std::cout << std::endl << "Finished in " << std::to_string(secs) << "s." << std::endl;
 
         return success;
     }else if(actionStr == "buildall") {
+        Timer buildTimer;
+        buildTimer.Start();
+
         // Scanning
-        std::vector<std::string> resources = ScanResources(j_buildConfig);
+        std::vector<std::string> resources;
+        {
+            TraceSpan scanSpan("scan");
+            resources = ScanResources(j_buildConfig);
+        }
 
         // Building
-        Timer buildTimer;
-        buildTimer.Start();
+
+        std::vector<ResourceInfo> resInfos;
 
         for(auto &resURI : resources) {
             // Getting data
@@ -509,29 +820,338 @@ int main(int argc, char **argv) {
                 return 1;
             }
 
-            // Build
-            std::cout << "Building " << resTypeStr << " resource: \"" << resName << "\"... ";
-            const auto resInfo = ResourceInfo {
+            resInfos.push_back(ResourceInfo {
                 resType,
                 resName,
                 resPaths
-            };
+            });
+        }
 
+        // Results are printed in scan order, as soon as all earlier ones are done.
+        struct BuildResult {
+            std::string output;
+            std::string warning;
+            bool done = false;
+            bool failed = false;
+        };
 
-            const ResourceCheckError resError = CheckResourceIntegrity(resInfo);
-            if(resError != ResourceCheckError::None) {
-                std::cout << ("\e[1;31m" + GetResourceCheckErrorString(resError) + "\e[0m.") << std::endl;
-                continue;
+        const bool useCache = j_buildConfig["build_options"]["use_cache"].get<bool>();
+
+        BuildCache cache;
+        if(useCache) cache.Load(GALAMAKE_CACHE_NAME, GetBuildOptionsKey(op_buildOptions));
+
+        const std::string sharedCacheDir = GetSharedCacheDirectory(j_buildConfig);
+
+        SharedCache sharedCache;
+        if(!sharedCacheDir.empty() && !sharedCache.Open(sharedCacheDir, GetBuildOptionsKey(op_buildOptions)))
+            PrintWarning("shared cache directory '" + sharedCacheDir + "' is unavailable; building without it.");
+
+        JobPool pool(op_jobCount);
+        op_buildOptions.pool = &pool; // Builders split their work on this pool too, never on one of their own.
+
+        // Atlas pages, before the sprites and nslices that point into them.
+        if(op_buildOptions.atlas) {
+            std::vector<ValidatedResource> atlasResources;
+
+            for(auto &resInfo : resInfos) {
+                if((resInfo.type != ResourceType::Sprite) && (resInfo.type != ResourceType::NSlice)) continue;
+
+                // Invalid resources are left out here, and reported when built.
+                ValidatedResource validated;
+                if(CheckResourceIntegrity(resInfo, validated) == ResourceCheckError::None)
+                    atlasResources.push_back(std::move(validated));
             }
 
-            const bool success = BuildResource(resInfo);
-            std::cout << (success ? "\e[0;32mDONE" : "\e[1;31mFAILED") << "\e[0m." << std::endl;
+            std::cout << "Packing " << atlasResources.size() << " textures into atlas pages... ";
+
+            const bool atlasSuccess = BuildAtlases(j_buildConfig, atlasResources, op_buildOptions.atlasSize, pool, op_buildOptions.atlasPlacements);
+            std::cout << (atlasSuccess ? "\e[0;32mDONE" : "\e[1;31mFAILED") << "\e[0m." << std::endl;
+
+            if(!atlasSuccess) {
+                if(!op_traceFile.empty()) GetTracer().Save(op_traceFile);
+                return 1;
+            }
+
+            std::cout << std::endl;
+        }else {
+            ClearAtlasPages(j_buildConfig); // Built resources no longer point into them.
+        }
+
+        std::vector<BuildResult> results(resInfos.size());
+        std::mutex outputMutex;
+        size_t nextOutput = 0;
+        bool buildFailed = false;
+
+        for(size_t i = 0; i < resInfos.size(); i++) {
+            pool.Submit([&, i] {
+                const ResourceInfo &resInfo = resInfos[i];
+                BuildResult result;
+
+                {
+                    std::lock_guard<std::mutex> lock(outputMutex);
+                    if(buildFailed) result.done = true; // Fail fast: skip what hasn't started.
+                }
+
+                if(!result.done) {
+                    const BuildStepResult step = BuildResourceStep(resInfo, useCache ? &cache : nullptr, &sharedCache, op_buildOptions);
+                    result.output = step.output;
+                    result.warning = step.warning;
+                    result.failed = step.failed;
+                    result.done = true;
+                }
+
+                std::lock_guard<std::mutex> lock(outputMutex);
+                results[i] = result;
+                if(result.failed) buildFailed = true;
+
+                while((nextOutput < results.size()) && results[nextOutput].done) {
+                    if(!results[nextOutput].output.empty())
+                        std::cout << results[nextOutput].output << std::endl;
 
-            if(!success) return 1;
+                    if(!results[nextOutput].warning.empty())
+                        PrintWarning(results[nextOutput].warning);
+
+                    if(results[nextOutput].failed) {
+                        nextOutput = results.size(); // Nothing is printed past a failure.
+                        break;
+                    }
+
+                    nextOutput++;
+                }
+            });
         }
 
+        pool.Wait();
+
+        if(useCache) cache.Save(GALAMAKE_CACHE_NAME);
+
+        if(!buildFailed && op_doPack) {
+            std::cout << std::endl;
+            buildFailed = !PackResources(j_buildConfig);
+        }
+
+        if(!op_traceFile.empty()) GetTracer().Save(op_traceFile);
+
+        if(buildFailed) return 1;
+
         std::cout << std::endl << "Finished in " << std::to_string(buildTimer.Stop()) << "s." << std::endl;
 
+        return 0;
+    }else if(actionStr == "pack") {
+        Timer packTimer;
+        packTimer.Start();
+
+        const bool success = PackResources(j_buildConfig);
+        if(!op_traceFile.empty()) GetTracer().Save(op_traceFile);
+
+        if(!success) return 1;
+
+        std::cout << std::endl << "Finished in " << std::to_string(packTimer.Stop()) << "s." << std::endl;
+
+        return 0;
+    }else if(actionStr == "watch") {
+        WorkspaceWatcher watcher;
+
+        if(!watcher.Start(j_buildConfig)) {
+            PrintError(ToolError::WatchUnavailable);
+            return 1;
+        }
+
+        const bool useCache = j_buildConfig["build_options"]["use_cache"].get<bool>();
+
+        BuildCache cache;
+        if(useCache) cache.Load(GALAMAKE_CACHE_NAME, GetBuildOptionsKey(op_buildOptions));
+
+        const std::string sharedCacheDir = GetSharedCacheDirectory(j_buildConfig);
+
+        SharedCache sharedCache;
+        if(!sharedCacheDir.empty() && !sharedCache.Open(sharedCacheDir, GetBuildOptionsKey(op_buildOptions)))
+            PrintWarning("shared cache directory '" + sharedCacheDir + "' is unavailable; building without it.");
+
+        // A resource is never built twice at once: changes to one that is
+        // already building queue a single rebuild for when it finishes.
+        std::mutex stateMutex;
+        std::set<std::string> building, rebuildAfter;
+        std::function<void(const ResourceInfo &)> scheduleBuild;
+
+        JobPool pool(op_jobCount);
+        op_buildOptions.pool = &pool;
+
+        scheduleBuild = [&](const ResourceInfo &resInfo) {
+            const std::string resURI = GetResourceTypeString(resInfo.type) + ":" + resInfo.name;
+
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+
+                if(building.count(resURI) > 0) {
+                    rebuildAfter.insert(resURI);
+                    return;
+                }
+
+                building.insert(resURI);
+            }
+
+            pool.Submit([&, resInfo, resURI] {
+                Timer buildTimer;
+                buildTimer.Start();
+
+                const BuildStepResult step = BuildResourceStep(resInfo, useCache ? &cache : nullptr, &sharedCache, op_buildOptions);
+                if(useCache) cache.Save(GALAMAKE_CACHE_NAME);
+
+                const double secs = buildTimer.Stop();
+
+                bool rebuild = false;
+                {
+                    std::lock_guard<std::mutex> lock(stateMutex);
+                    std::cout << step.output << " (" << std::to_string(secs) << "s)" << std::endl;
+                    if(!step.warning.empty()) PrintWarning(step.warning);
+
+                    building.erase(resURI);
+                    rebuild = (rebuildAfter.erase(resURI) > 0);
+                }
+
+                if(rebuild) scheduleBuild(resInfo);
+            });
+        };
+
+        std::cout << "Watching for changes... (press ^C to stop)" << std::endl;
+
+        while(true) {
+            for(auto &resURI : watcher.WaitForChanges()) {
+                const auto [resTypeStr, resName] = SplitResourceURI(resURI);
+                const ResourceType resType = g_typeStrs[resTypeStr];
+                const ResourcePathInfo resPaths = GenResourcePaths(j_buildConfig, resType, resName);
+
+                // Removed resources have nothing left to build.
+                if(!std::filesystem::is_directory(resPaths.inputPath)) continue;
+
+                scheduleBuild(ResourceInfo {
+                    resType,
+                    resName,
+                    resPaths
+                });
+            }
+        }
+
+        return 0;
+    }else if(actionStr == "info") {
+        // Guarding
+        if(args.size() != 2) {
+            PrintError(ToolError::InvalidArgumentCount);
+            return 1;
+        }
+
+        // Getting data
+        const std::string &resURI = args[1];
+        const auto [resTypeStr, resName] = SplitResourceURI(resURI);
+
+        if(g_typeStrs.count(resTypeStr) == 0) {
+            PrintError(ToolError::InvalidResourceType, resTypeStr);
+            return 1;
+        }
+
+        const ResourcePathInfo resPaths = GenResourcePaths(j_buildConfig, g_typeStrs[resTypeStr], resName);
+
+        if(!std::filesystem::exists(resPaths.outputPath)) {
+            PrintError(ToolError::ResourceNotBuilt, resURI);
+            return 1;
+        }
+
+        MappedTable table;
+        if(!table.Open(resPaths.outputPath)) {
+            PrintError(ToolError::InvalidResourceData, resPaths.outputPath);
+            return 1;
+        }
+
+        // Listing
+        std::cout << "'" << resPaths.outputPath << "': " << table.GetItemCount() << " items." << std::endl;
+
+        for(auto &item : table.GetDirectory()) {
+            std::cout
+                << "    " << std::left << std::setw(24) << item.name
+                << std::setw(12) << xdt::GetTypeString(item.type)
+                << GetItemValueString(item)
+                << std::endl;
+        }
+
+        return 0;
+    }else if(actionStr == "benchmark") {
+        // Guarding
+        if(args.size() != 2) {
+            PrintError(ToolError::InvalidArgumentCount);
+            return 1;
+        }
+
+        const std::string &benchmarkStr = args[1];
+
+        if((benchmarkStr != "compression") && (benchmarkStr != "qoi")) {
+            PrintError(ToolError::InvalidOption, benchmarkStr);
+            return 1;
+        }
+
+        // Samples from each built resource, by type: its (uncompressed) BLOB
+        // items, or its decoded textures.
+        std::map<std::string, std::vector<std::vector<uint8_t>>> samples;
+        std::map<std::string, std::vector<ImageSample>> imageSamples;
+        size_t totalBytes = 0;
+
+        for(auto &resURI : ScanResources(j_buildConfig)) {
+            const auto [resTypeStr, resName] = SplitResourceURI(resURI);
+            if(g_typeStrs.count(resTypeStr) == 0) continue;
+
+            const ResourcePathInfo resPaths = GenResourcePaths(j_buildConfig, g_typeStrs[resTypeStr], resName);
+
+            MappedTable table;
+            if(!table.Open(resPaths.outputPath)) {
+                std::cout << "Skipping unbuilt resource: \"" << resURI << "\"." << std::endl;
+                continue;
+            }
+
+            for(auto &item : table.GetDirectory()) {
+                if(item.size < GALAMAKE_COMPRESSION_MIN_SIZE) continue;
+
+                std::vector<uint8_t> bytes;
+                if(!table.ReadBytes(item.name, bytes)) continue;
+
+                if(benchmarkStr == "qoi") {
+                    if(item.name != "texture") continue;
+
+                    ImageSample image;
+                    if(!DecodeQOI(bytes.data(), bytes.size(), image.pixels, image.width, image.height, image.channels)) continue;
+
+                    totalBytes += image.pixels.size();
+                    imageSamples[resTypeStr].push_back(std::move(image));
+                }else {
+                    totalBytes += bytes.size();
+                    samples[resTypeStr].push_back(std::move(bytes));
+                }
+            }
+        }
+
+        if(samples.empty() && imageSamples.empty()) {
+            std::cout << "Nothing to benchmark. Try 'galamake buildall' first." << std::endl;
+            return 1;
+        }
+
+        std::cout << "Benchmarking " << benchmarkStr << " on " << std::to_string(totalBytes / 1048576.0) << " MiB of data...\n" << std::endl;
+
+        // Benchmarking
+        std::vector<std::pair<std::string, BenchmarkResult>> results;
+
+        for(auto &[resTypeStr, typeSamples] : samples) {
+            for(auto compression : {Compression::RLE, Compression::LZ77, Compression::Deflate})
+                results.emplace_back(resTypeStr, BenchmarkCompression(typeSamples, compression));
+        }
+
+        for(auto &[resTypeStr, typeSamples] : imageSamples) {
+            for(auto path : {QOIPath::Scalar, QOIPath::SSE41, QOIPath::AVX2}) {
+                if(IsQOIPathSupported(path))
+                    results.emplace_back(resTypeStr, BenchmarkQOI(typeSamples, path));
+            }
+        }
+
+        PrintBenchmarkResults(results);
+
         return 0;
     }else if(actionStr == "scan") {
         // Scanning
@@ -631,16 +1251,17 @@ int main(int argc, char **argv) {
             std::cout << "Checking " << resTypeStr << " resource: \"" << resName << "\"... ";
 
             const ResourceType resType = g_typeStrs[resTypeStr];
+            ValidatedResource validated;
             const auto resError = CheckResourceIntegrity(ResourceInfo {
                 resType,
                 resName,
                 GenResourcePaths(j_buildConfig, resType, resName)
-            });
+            }, validated);
 
             if(resError != ResourceCheckError::None) invalidResources.push_back(resURI);
 
             std::cout
-                << ((resError == ResourceCheckError::None) ? "\e[0;32mOK" : ("\e[1;31m" + GetResourceCheckErrorString(resError)))
+                << ((resError == ResourceCheckError::None) ? "\e[0;32mOK" : ("\e[1;31m" + GetResourceCheckErrorString(resError, validated.failedField)))
                 << "\e[0m." << std::endl;
 
             totalResources++;
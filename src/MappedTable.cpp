@@ -0,0 +1,289 @@
+#include <GalaMake/MappedTable.hpp>
+#include <GalaMake/Compression.hpp>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+
+#define XDT_HEADER_SIZE 10
+
+static inline uint64_t ReadLE(const uint8_t *p, size_t bytes) {
+    uint64_t value = 0;
+    for(size_t i = 0; i < bytes; i++)
+        value |= (uint64_t)p[i] << (i * 8);
+
+    return value;
+}
+
+static inline bool IsBLOBType(xdt::ItemType type) {
+    return std::find(xdt::BLOBTypes.begin(), xdt::BLOBTypes.end(), type) != xdt::BLOBTypes.end();
+}
+
+// Size of an inline (non-BLOB) value, within its 4-byte directory field.
+size_t GetItemValueSize(xdt::ItemType type) {
+    switch(type) {
+        case xdt::ItemType::Byte:       return 1; break;
+        case xdt::ItemType::Bool:       return 1; break;
+        case xdt::ItemType::Int16:      return 2; break;
+        case xdt::ItemType::Uint16:     return 2; break;
+        default:
+            return 4;
+            break;
+    }
+}
+
+bool MappedTable::ParseDirectory() {
+    const uint8_t *p = mapping;
+    const uint8_t *end = mapping + mappingSize;
+
+    // Header
+    if(mappingSize < XDT_HEADER_SIZE) return false;
+    if(ReadLE(p, 4) != __builtin_bswap32(XDT_MAGIC)) return false;
+
+    headerInfo.version = (p[4] << 8) | p[5];
+    headerInfo.flags.low = p[6];
+    headerInfo.flags.high = p[7];
+
+    const size_t itemCount = ReadLE(p + 8, 2);
+    p += XDT_HEADER_SIZE;
+
+    // Directory, noting where each BLOB's data will be relative to the first.
+    std::vector<size_t> blobOffsets(itemCount, 0);
+    size_t blobBytes = 0;
+
+    directory.reserve(itemCount);
+
+    for(size_t i = 0; i < itemCount; i++) {
+        if((end - p) < 1) return false;
+        const size_t nameLength = *p++;
+
+        if((size_t)(end - p) < (nameLength + 7)) return false;
+
+        ItemView item;
+        item.name = std::string_view((const char *)p, nameLength);
+        p += nameLength;
+
+        item.type = (xdt::ItemType)*p++;
+        const uint8_t *value = p;
+        p += 4;
+
+        item.flags.low = *p++;
+        item.flags.high = *p++;
+
+        if(IsBLOBType(item.type)) {
+            item.data = nullptr;
+            item.size = ReadLE(value, 4);
+            blobOffsets[i] = blobBytes;
+            blobBytes += item.size;
+        }else {
+            item.data = value;
+            item.size = GetItemValueSize(item.type);
+        }
+
+        directory.push_back(item);
+    }
+
+    // BLOB data follows the directory, in directory order.
+    if((size_t)(end - p) < blobBytes) return false;
+
+    for(size_t i = 0; i < itemCount; i++) {
+        if(IsBLOBType(directory[i].type))
+            directory[i].data = p + blobOffsets[i];
+
+        index.try_emplace(directory[i].name, i); // First of any duplicates wins, as in xdt::Table.
+    }
+
+    return true;
+}
+
+bool MappedTable::Open(const std::string &filename) {
+    Close();
+
+    const int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd < 0) return false;
+
+    struct stat st;
+    if((fstat(fd, &st) != 0) || (st.st_size <= 0)) {
+        close(fd);
+        return false;
+    }
+
+    void *address = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps the file open.
+
+    if(address == MAP_FAILED) return false;
+
+    mapping = (const uint8_t *)address;
+    mappingSize = st.st_size;
+
+    if(!ParseDirectory()) {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void MappedTable::Close() {
+    if(mapping) munmap((void *)mapping, mappingSize);
+
+    mapping = nullptr;
+    mappingSize = 0;
+    directory.clear();
+    index.clear();
+    headerInfo = xdt::HeaderInfo();
+}
+
+bool MappedTable::IsOpen() const {
+    return mapping != nullptr;
+}
+
+// General item stuff
+const MappedTable::ItemView *MappedTable::GetItem(std::string_view itemName) const {
+    const auto it = index.find(itemName);
+    if(it == index.end()) return nullptr;
+
+    return &directory[it->second];
+}
+
+bool MappedTable::ItemExists(std::string_view itemName) const {
+    return index.count(itemName) > 0;
+}
+
+size_t MappedTable::GetItemCount() const {
+    return directory.size();
+}
+
+const std::vector<MappedTable::ItemView> &MappedTable::GetDirectory() const {
+    return directory;
+}
+
+// Getters
+std::string_view MappedTable::GetString(std::string_view itemName) const {
+    const ItemView *item = GetItem(itemName);
+    if(!item || (GetItemCompression(item->flags) != Compression::None)) return {};
+
+    if((item->type != xdt::ItemType::ASCIIString) && (item->type != xdt::ItemType::UTF8String)) return {};
+
+    return std::string_view((const char *)item->data, item->size);
+}
+
+int64_t MappedTable::GetInteger(std::string_view itemName) const {
+    const ItemView *item = GetItem(itemName);
+    if(!item || (GetItemCompression(item->flags) != Compression::None)) return 0;
+
+    switch(item->type) {
+        case xdt::ItemType::Byte:           return (uint8_t)ReadLE(item->data, 1); break;
+        case xdt::ItemType::Bool:           return item->data[0] != 0; break;
+        case xdt::ItemType::Int16:          return (int16_t)ReadLE(item->data, 2); break;
+        case xdt::ItemType::Uint16:         return (uint16_t)ReadLE(item->data, 2); break;
+        case xdt::ItemType::Int32:          return (int32_t)ReadLE(item->data, 4); break;
+        case xdt::ItemType::Timestamp:      return (int32_t)ReadLE(item->data, 4); break;
+        case xdt::ItemType::Uint32:         return (uint32_t)ReadLE(item->data, 4); break;
+        case xdt::ItemType::Int64:          return (item->size == 8) ? (int64_t)ReadLE(item->data, 8) : 0; break;
+        case xdt::ItemType::Uint64:         return (item->size == 8) ? (int64_t)ReadLE(item->data, 8) : 0; break;
+        case xdt::ItemType::LongTimestamp:  return (item->size == 8) ? (int64_t)ReadLE(item->data, 8) : 0; break;
+        default:
+            return 0;
+            break;
+    }
+}
+
+double MappedTable::GetFloat(std::string_view itemName) const {
+    const ItemView *item = GetItem(itemName);
+    if(!item || (GetItemCompression(item->flags) != Compression::None)) return 0.0;
+
+    if(item->type == xdt::ItemType::Float) {
+        float value;
+        std::memcpy(&value, item->data, sizeof(value));
+        return value;
+    }
+
+    if((item->type == xdt::ItemType::Double) && (item->size == sizeof(double))) {
+        double value;
+        std::memcpy(&value, item->data, sizeof(value));
+        return value;
+    }
+
+    return (double)GetInteger(itemName);
+}
+
+bool MappedTable::ReadBytes(std::string_view itemName, std::vector<uint8_t> &out) const {
+    const ItemView *item = GetItem(itemName);
+    if(!item) return false;
+
+    return DecompressBytes(item->data, item->size, GetItemCompression(item->flags), out);
+}
+
+MappedTable::MappedTable() {}
+
+MappedTable::~MappedTable() {
+    Close();
+}
+
+// Printable summary of an item's value; BLOBs other than strings show their size.
+std::string GetItemValueString(const MappedTable::ItemView &item, size_t maxLength) {
+    std::string text;
+
+    const Compression compression = GetItemCompression(item.flags);
+    if(compression != Compression::None)
+        return "<" + std::to_string(item.size) + " bytes, " + GetCompressionString(compression) + ">";
+
+    switch(item.type) {
+        case xdt::ItemType::ASCIIString:
+        case xdt::ItemType::UTF8String:
+            text.assign((const char *)item.data, item.size);
+            if(text.size() > maxLength) text = text.substr(0, maxLength) + "...";
+
+            for(auto &c : text)
+                if((c == '\n') || (c == '\r') || (c == '\t')) c = ' ';
+
+            return "\"" + text + "\"";
+            break;
+
+        case xdt::ItemType::File:
+        case xdt::ItemType::Raw:
+        case xdt::ItemType::Int64:
+        case xdt::ItemType::Uint64:
+        case xdt::ItemType::LongTimestamp:
+        case xdt::ItemType::Double:
+            if((item.type == xdt::ItemType::File) || (item.type == xdt::ItemType::Raw) || (item.size != 8))
+                return "<" + std::to_string(item.size) + " bytes>";
+            break;
+
+        default:
+            break;
+    }
+
+    // Scalars
+    uint64_t raw = 0;
+    for(size_t i = 0; i < item.size; i++)
+        raw |= (uint64_t)item.data[i] << (i * 8);
+
+    switch(item.type) {
+        case xdt::ItemType::Bool:   return raw ? "true" : "false"; break;
+        case xdt::ItemType::Int16:  return std::to_string((int16_t)raw); break;
+        case xdt::ItemType::Int32:  return std::to_string((int32_t)raw); break;
+        case xdt::ItemType::Int64:  return std::to_string((int64_t)raw); break;
+        case xdt::ItemType::Timestamp:      return std::to_string((int32_t)raw); break;
+        case xdt::ItemType::LongTimestamp:  return std::to_string((int64_t)raw); break;
+
+        case xdt::ItemType::Float: {
+            float value;
+            std::memcpy(&value, item.data, sizeof(value));
+            return std::to_string(value);
+        } break;
+
+        case xdt::ItemType::Double: {
+            double value;
+            std::memcpy(&value, item.data, sizeof(value));
+            return std::to_string(value);
+        } break;
+
+        default:
+            return std::to_string(raw);
+            break;
+    }
+}
\ No newline at end of file
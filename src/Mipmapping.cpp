@@ -0,0 +1,165 @@
+#include <GalaMake/Mipmapping.hpp>
+
+#include <cmath>
+#include <mutex>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define MIP_SSE2
+#endif
+
+// Levels are filtered as 16-bit linear RGBA, premultiplied by alpha (so the
+// colour of transparent texels doesn't bleed into their neighbours), and only
+// turned back into 8-bit sRGB for output, so rounding doesn't build up down
+// the chain.
+struct LinearImage {
+    std::vector<uint16_t> pixels;
+    int width = 0;
+    int height = 0;
+};
+
+static uint16_t s_toLinear[256];
+static uint8_t  s_toSRGB[65536];
+
+static void InitTables() {
+    static std::once_flag once;
+
+    std::call_once(once, [] {
+        for(int i = 0; i < 256; i++) {
+            const double c = i / 255.0;
+            const double linear = (c <= 0.04045) ? (c / 12.92) : std::pow((c + 0.055) / 1.055, 2.4);
+            s_toLinear[i] = (uint16_t)std::lround(linear * 65535.0);
+        }
+
+        for(int i = 0; i < 65536; i++) {
+            const double l = i / 65535.0;
+            const double c = (l <= 0.0031308) ? (l * 12.92) : (1.055 * std::pow(l, 1.0 / 2.4) - 0.055);
+            s_toSRGB[i] = (uint8_t)std::lround(std::min(std::max(c, 0.0), 1.0) * 255.0);
+        }
+    });
+}
+
+static LinearImage ToLinear(const RGBAImage &image) {
+    LinearImage out;
+    out.width = image.width;
+    out.height = image.height;
+    out.pixels.resize(image.pixels.size());
+
+    for(size_t i = 0; i < image.pixels.size(); i += 4) {
+        const uint32_t alpha = image.pixels[i + 3] * 257;
+
+        for(int c = 0; c < 3; c++)
+            out.pixels[i + c] = ((uint32_t)s_toLinear[image.pixels[i + c]] * alpha + 32767) / 65535;
+
+        out.pixels[i + 3] = alpha;
+    }
+
+    return out;
+}
+
+static RGBAImage ToSRGB(const LinearImage &image) {
+    RGBAImage out;
+    out.width = image.width;
+    out.height = image.height;
+    out.pixels.resize(image.pixels.size());
+
+    for(size_t i = 0; i < image.pixels.size(); i += 4) {
+        const uint32_t alpha = image.pixels[i + 3];
+
+        // Un-premultiply (fully transparent texels are left black).
+        for(int c = 0; c < 3; c++) {
+            const uint32_t linear = (alpha > 0) ? std::min<uint32_t>(((uint32_t)image.pixels[i + c] * 65535 + alpha / 2) / alpha, 65535) : 0;
+            out.pixels[i + c] = s_toSRGB[linear];
+        }
+
+        out.pixels[i + 3] = (alpha + 128) / 257;
+    }
+
+    return out;
+}
+
+// Averages 2x2 blocks. As with GPU mip generation, an odd last row or column
+// is left out; a 1-pixel dimension averages with itself.
+static void DownsampleRows(const uint16_t *row0, const uint16_t *row1, uint16_t *out, int srcWidth, int dstWidth) {
+    int x = 0;
+
+#ifdef MIP_SSE2
+    // Two output pixels (four input pixels per row) at a time. Sums are made
+    // in 32 bits; the pack is signed, so values are biased by 32768 around it.
+    if(srcWidth >= 2) {
+        const __m128i zero  = _mm_setzero_si128();
+        const __m128i round = _mm_set1_epi32(2);
+        const __m128i bias  = _mm_set1_epi32(32768);
+        const __m128i unbias = _mm_set1_epi16((short)0x8000);
+
+        for(; (x + 2 <= dstWidth) && (x*2 + 4 <= srcWidth); x += 2) {
+            const __m128i a0 = _mm_loadu_si128((const __m128i *)(row0 + x*8));
+            const __m128i a1 = _mm_loadu_si128((const __m128i *)(row0 + x*8 + 8));
+            const __m128i b0 = _mm_loadu_si128((const __m128i *)(row1 + x*8));
+            const __m128i b1 = _mm_loadu_si128((const __m128i *)(row1 + x*8 + 8));
+
+            // Pixel pairs {p0, p1} of each row, widened to 32 bits per channel.
+            const __m128i sum0 = _mm_add_epi32(
+                _mm_add_epi32(_mm_unpacklo_epi16(a0, zero), _mm_unpackhi_epi16(a0, zero)),
+                _mm_add_epi32(_mm_unpacklo_epi16(b0, zero), _mm_unpackhi_epi16(b0, zero))
+            );
+            const __m128i sum1 = _mm_add_epi32(
+                _mm_add_epi32(_mm_unpacklo_epi16(a1, zero), _mm_unpackhi_epi16(a1, zero)),
+                _mm_add_epi32(_mm_unpacklo_epi16(b1, zero), _mm_unpackhi_epi16(b1, zero))
+            );
+
+            const __m128i avg0 = _mm_sub_epi32(_mm_srli_epi32(_mm_add_epi32(sum0, round), 2), bias);
+            const __m128i avg1 = _mm_sub_epi32(_mm_srli_epi32(_mm_add_epi32(sum1, round), 2), bias);
+
+            _mm_storeu_si128((__m128i *)(out + x*4), _mm_xor_si128(_mm_packs_epi32(avg0, avg1), unbias));
+        }
+    }
+#endif
+
+    for(; x < dstWidth; x++) {
+        const int sx0 = std::min(x*2, srcWidth - 1);
+        const int sx1 = std::min(x*2 + 1, srcWidth - 1);
+
+        for(int c = 0; c < 4; c++) {
+            const uint32_t sum = (uint32_t)row0[sx0*4 + c] + row0[sx1*4 + c] + row1[sx0*4 + c] + row1[sx1*4 + c];
+            out[x*4 + c] = (sum + 2) / 4;
+        }
+    }
+}
+
+static LinearImage Downsample(const LinearImage &image) {
+    LinearImage out;
+    out.width = std::max(image.width / 2, 1);
+    out.height = std::max(image.height / 2, 1);
+    out.pixels.resize((size_t)out.width * out.height * 4);
+
+    for(int y = 0; y < out.height; y++) {
+        const int sy0 = std::min(y*2, image.height - 1);
+        const int sy1 = std::min(y*2 + 1, image.height - 1);
+
+        DownsampleRows(
+            image.pixels.data() + (size_t)sy0 * image.width * 4,
+            image.pixels.data() + (size_t)sy1 * image.width * 4,
+            out.pixels.data() + (size_t)y * out.width * 4,
+            image.width, out.width
+        );
+    }
+
+    return out;
+}
+
+std::vector<RGBAImage> GenerateMipmaps(const RGBAImage &image) {
+    std::vector<RGBAImage> levels;
+    if((image.width <= 0) || (image.height <= 0)) return levels;
+
+    InitTables();
+
+    LinearImage level = ToLinear(image);
+
+    while((level.width > 1) || (level.height > 1)) {
+        level = Downsample(level);
+        levels.push_back(ToSRGB(level));
+    }
+
+    return levels;
+}
\ No newline at end of file
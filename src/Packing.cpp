@@ -0,0 +1,116 @@
+#include <GalaMake/Packing.hpp>
+#include <GalaMake/Utils.hpp>
+
+static inline void WriteLE(std::vector<uint8_t> &out, uint64_t value, size_t bytes) {
+    for(size_t i = 0; i < bytes; i++)
+        out.push_back((value >> (i * 8)) & 0xFF);
+}
+
+static inline uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+std::string GetPackPath(const json &buildConfig) {
+    const auto &buildOptions = buildConfig["build_options"];
+
+    if(buildOptions.contains("pack_file") && buildOptions["pack_file"].is_string())
+        return buildOptions["pack_file"].get<std::string>();
+
+    return buildOptions["output_dir"].get<std::string>() + "resources.gpak";
+}
+
+bool WritePack(const std::string &filename, const std::vector<PackEntry> &entries) {
+    struct IndexEntry {
+        uint64_t hash;
+        uint64_t offset;
+        uint64_t size;
+        const PackEntry *entry;
+    };
+
+    // Index
+    std::vector<IndexEntry> index;
+
+    for(auto &e : entries) {
+        std::error_code ec;
+        const uint64_t size = std::filesystem::file_size(e.path, ec);
+        if(ec) return false;
+
+        index.push_back({HashBytes(e.uri.data(), e.uri.size()), 0, size, &e});
+    }
+
+    std::sort(index.begin(), index.end(), [](const IndexEntry &a, const IndexEntry &b) {
+        if(a.hash != b.hash) return a.hash < b.hash;
+        return a.entry->uri < b.entry->uri;
+    });
+
+    // Layout
+    std::string strings;
+    std::vector<uint32_t> nameOffsets;
+
+    for(auto &i : index) {
+        nameOffsets.push_back(strings.size());
+        strings += i.entry->uri;
+    }
+
+    uint64_t offset = AlignUp(
+        GALAMAKE_PACK_HEADER_SIZE + index.size() * GALAMAKE_PACK_ENTRY_SIZE + strings.size(),
+        GALAMAKE_PACK_ALIGNMENT
+    );
+
+    for(auto &i : index) {
+        i.offset = offset;
+        offset = AlignUp(offset + i.size, GALAMAKE_PACK_ALIGNMENT);
+    }
+
+    // Head: header, index and strings
+    std::vector<uint8_t> head;
+    head.insert(head.end(), GALAMAKE_PACK_MAGIC, GALAMAKE_PACK_MAGIC + 4);
+    WriteLE(head, GALAMAKE_PACK_VERSION, 2);
+    WriteLE(head, 0, 2);
+    WriteLE(head, index.size(), 4);
+    WriteLE(head, strings.size(), 4);
+
+    for(size_t i = 0; i < index.size(); i++) {
+        WriteLE(head, index[i].hash, 8);
+        WriteLE(head, index[i].offset, 8);
+        WriteLE(head, index[i].size, 8);
+        WriteLE(head, nameOffsets[i], 4);
+        WriteLE(head, index[i].entry->uri.size(), 4);
+    }
+
+    head.insert(head.end(), strings.begin(), strings.end());
+
+    // Write, streaming payloads in from their files.
+    std::ofstream f(filename, std::ios::binary);
+    if(!f.good()) return false;
+
+    f.write((const char *)head.data(), head.size());
+
+    std::vector<char> buffer(1 << 20);
+
+    for(auto &i : index) {
+        f.seekp(i.offset);
+
+        std::ifstream f_in(i.entry->path, std::ios::binary);
+        if(!f_in.good()) return false;
+
+        uint64_t remaining = i.size;
+        while(remaining > 0) {
+            f_in.read(buffer.data(), std::min<uint64_t>(remaining, buffer.size()));
+            if(f_in.gcount() <= 0) return false;
+
+            f.write(buffer.data(), f_in.gcount());
+            remaining -= f_in.gcount();
+        }
+    }
+
+    // Pad the final payload out, so every payload's page is whole.
+    if(!index.empty() && ((uint64_t)f.tellp() < offset)) {
+        f.seekp(offset - 1);
+        f.put(0);
+    }
+
+    f.close();
+
+    return f.good();
+}
\ No newline at end of file
@@ -72,20 +72,22 @@ ResourcePathInfo GetFontsDirectories(const json &buildConfig) {
     return {inputDirectory, outputDirectory};
 }
 
-ResourcePathInfo GenResourcePaths(const json &buildConfig, ResourceType type, const std::string &resourceName) {
-    ResourcePathInfo resDirs;
-
+ResourcePathInfo GetResourceDirectories(const json &buildConfig, ResourceType type) {
     switch(type) {
-        case ResourceType::Texture: resDirs = GetTexturesDirectories(buildConfig); break;
-        case ResourceType::Sprite:  resDirs = GetSpritesDirectories(buildConfig); break;
-        case ResourceType::Tileset: resDirs = GetTilesetsDirectories(buildConfig); break;
-        case ResourceType::NSlice:  resDirs = GetNSlicesDirectories(buildConfig); break;
-        case ResourceType::Sound:   resDirs = GetSoundsDirectories(buildConfig); break;
-        case ResourceType::Font:    resDirs = GetFontsDirectories(buildConfig); break;
+        case ResourceType::Texture: return GetTexturesDirectories(buildConfig); break;
+        case ResourceType::Sprite:  return GetSpritesDirectories(buildConfig); break;
+        case ResourceType::Tileset: return GetTilesetsDirectories(buildConfig); break;
+        case ResourceType::NSlice:  return GetNSlicesDirectories(buildConfig); break;
+        case ResourceType::Sound:   return GetSoundsDirectories(buildConfig); break;
+        case ResourceType::Font:    return GetFontsDirectories(buildConfig); break;
         default:
-            resDirs = {"", ""};
+            return {"", ""};
             break;
     }
+}
+
+ResourcePathInfo GenResourcePaths(const json &buildConfig, ResourceType type, const std::string &resourceName) {
+    const ResourcePathInfo resDirs = GetResourceDirectories(buildConfig, type);
 
     return {
         resDirs.inputPath + resourceName + "/",
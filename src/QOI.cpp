@@ -0,0 +1,416 @@
+#include <GalaMake/QOI.hpp>
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define QOI_X86
+#endif
+
+#define QOI_OP_INDEX 0x00
+#define QOI_OP_DIFF  0x40
+#define QOI_OP_LUMA  0x80
+#define QOI_OP_RUN   0xC0
+#define QOI_OP_RGB   0xFE
+#define QOI_OP_RGBA  0xFF
+#define QOI_MASK_2   0xC0
+
+#define QOI_MAGIC    0x716F6966 // "qoif"
+#define QOI_SRGB     0
+#define QOI_MAX_RUN  62
+#define QOI_MAX_PIXELS 400000000 // Same limit as the reference decoder.
+
+#define QOI_CHUNK_PIXELS 4096           // Pixels analysed at a time; a multiple of 64.
+#define QOI_START_PIXEL  0xFF000000u    // {0, 0, 0, 255}, packed.
+
+// Pixels are packed into a uint32_t as their RGBA bytes in memory order
+// (R being the low byte, on the little-endian machines we build for).
+static inline uint8_t PixelR(uint32_t px) { return (px >>  0) & 0xFF; }
+static inline uint8_t PixelG(uint32_t px) { return (px >>  8) & 0xFF; }
+static inline uint8_t PixelB(uint32_t px) { return (px >> 16) & 0xFF; }
+static inline uint8_t PixelA(uint32_t px) { return (px >> 24) & 0xFF; }
+
+static inline uint32_t PackPixel(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    return r | (g << 8) | (b << 16) | ((uint32_t)a << 24);
+}
+
+static inline uint8_t HashPixel(uint32_t px) {
+    return (PixelR(px) * 3 + PixelG(px) * 5 + PixelB(px) * 7 + PixelA(px) * 11) % 64;
+}
+
+static inline void WriteBE32(uint8_t *out, uint32_t value) {
+    out[0] = (value >> 24) & 0xFF;
+    out[1] = (value >> 16) & 0xFF;
+    out[2] = (value >>  8) & 0xFF;
+    out[3] = (value >>  0) & 0xFF;
+}
+
+static inline uint32_t ReadBE32(const uint8_t *in) {
+    return ((uint32_t)in[0] << 24) | (in[1] << 16) | (in[2] << 8) | in[3];
+}
+
+// Analysis
+// Finds each pixel's index hash, and whether it repeats the pixel before it
+// (one bit per pixel), so the encoding loop can skip through runs a word at a
+// time. pixels[-1] must be the previous pixel.
+typedef void (*QOIAnalyseFunc)(const uint32_t *pixels, size_t count, uint8_t *hashes, uint64_t *repeats);
+
+static inline void AnalyseRange(const uint32_t *pixels, size_t begin, size_t end, uint8_t *hashes, uint64_t *repeats) {
+    for(size_t i = begin; i < end; i++) {
+        hashes[i] = HashPixel(pixels[i]);
+        if(pixels[i] == pixels[i - 1]) repeats[i / 64] |= 1ull << (i % 64);
+    }
+}
+
+static void AnalyseScalar(const uint32_t *pixels, size_t count, uint8_t *hashes, uint64_t *repeats) {
+    std::memset(repeats, 0, (count + 63) / 64 * sizeof(uint64_t));
+    AnalyseRange(pixels, 0, count, hashes, repeats);
+}
+
+#ifdef QOI_X86
+// The hash is a dot product of each pixel's bytes with {3, 5, 7, 11}: byte
+// pairs are multiplied and summed to 16 bits (maddubs), then those pairs to
+// 32 bits (madd). Repeats are a compare against the pixels shifted by one.
+__attribute__((target("sse4.1")))
+static void AnalyseSSE41(const uint32_t *pixels, size_t count, uint8_t *hashes, uint64_t *repeats) {
+    const __m128i weights = _mm_set1_epi32(0x0B070503);
+    const __m128i ones    = _mm_set1_epi16(1);
+    const __m128i mask    = _mm_set1_epi32(63);
+
+    std::memset(repeats, 0, (count + 63) / 64 * sizeof(uint64_t));
+
+    size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const __m128i cur  = _mm_loadu_si128((const __m128i *)(pixels + i));
+        const __m128i prev = _mm_loadu_si128((const __m128i *)(pixels + i - 1));
+
+        __m128i sums = _mm_and_si128(_mm_madd_epi16(_mm_maddubs_epi16(cur, weights), ones), mask);
+        sums = _mm_packus_epi32(sums, sums);
+        sums = _mm_packus_epi16(sums, sums);
+
+        const uint32_t packed = _mm_cvtsi128_si32(sums);
+        std::memcpy(hashes + i, &packed, 4);
+
+        const uint64_t bits = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(cur, prev)));
+        repeats[i / 64] |= bits << (i % 64);
+    }
+
+    AnalyseRange(pixels, i, count, hashes, repeats);
+}
+
+__attribute__((target("avx2")))
+static void AnalyseAVX2(const uint32_t *pixels, size_t count, uint8_t *hashes, uint64_t *repeats) {
+    const __m256i weights = _mm256_set1_epi32(0x0B070503);
+    const __m256i ones    = _mm256_set1_epi16(1);
+    const __m256i mask    = _mm256_set1_epi32(63);
+
+    // Low byte of each 32-bit hash, gathered to the bottom of each lane...
+    const __m256i gather = _mm256_setr_epi8(
+        0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+    );
+
+    // ...then both lanes' bytes brought together.
+    const __m256i order = _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0);
+
+    std::memset(repeats, 0, (count + 63) / 64 * sizeof(uint64_t));
+
+    size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m256i cur  = _mm256_loadu_si256((const __m256i *)(pixels + i));
+        const __m256i prev = _mm256_loadu_si256((const __m256i *)(pixels + i - 1));
+
+        __m256i sums = _mm256_and_si256(_mm256_madd_epi16(_mm256_maddubs_epi16(cur, weights), ones), mask);
+        sums = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(sums, gather), order);
+
+        _mm_storel_epi64((__m128i *)(hashes + i), _mm256_castsi256_si128(sums));
+
+        const uint64_t bits = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(cur, prev)));
+        repeats[i / 64] |= bits << (i % 64);
+    }
+
+    AnalyseRange(pixels, i, count, hashes, repeats);
+}
+#endif
+
+// Paths
+bool IsQOIPathSupported(QOIPath path) {
+    switch(path) {
+        case QOIPath::Auto:
+        case QOIPath::Scalar:
+            return true;
+            break;
+
+#ifdef QOI_X86
+        case QOIPath::SSE41:    return __builtin_cpu_supports("sse4.1"); break;
+        case QOIPath::AVX2:     return __builtin_cpu_supports("avx2"); break;
+#endif
+
+        default:
+            return false;
+            break;
+    }
+}
+
+QOIPath GetBestQOIPath() {
+    if(IsQOIPathSupported(QOIPath::AVX2))  return QOIPath::AVX2;
+    if(IsQOIPathSupported(QOIPath::SSE41)) return QOIPath::SSE41;
+
+    return QOIPath::Scalar;
+}
+
+std::string GetQOIPathString(QOIPath path) {
+    switch(path) {
+        case QOIPath::Auto:     return "auto"; break;
+        case QOIPath::Scalar:   return "scalar"; break;
+        case QOIPath::SSE41:    return "sse4.1"; break;
+        case QOIPath::AVX2:     return "avx2"; break;
+        default:
+            return "unknown";
+            break;
+    }
+}
+
+static QOIAnalyseFunc GetAnalyseFunc(QOIPath path) {
+    switch(path) {
+#ifdef QOI_X86
+        case QOIPath::SSE41:    return AnalyseSSE41; break;
+        case QOIPath::AVX2:     return AnalyseAVX2; break;
+#endif
+        default:
+            return AnalyseScalar;
+            break;
+    }
+}
+
+// Encoding
+std::vector<uint8_t> EncodeQOI(const uint8_t *pixels, int width, int height, int channels, QOIPath path) {
+    if((pixels == nullptr) || (width <= 0) || (height <= 0)) return {};
+    if((channels != 3) && (channels != 4)) return {};
+
+    if(path == QOIPath::Auto) path = GetBestQOIPath();
+    if(!IsQOIPathSupported(path)) return {};
+
+    const QOIAnalyseFunc analyse = GetAnalyseFunc(path);
+    const size_t pixelCount = (size_t)width * (size_t)height;
+
+    // Worst case is one RGBA op (5 bytes) per pixel.
+    std::vector<uint8_t> out(QOI_HEADER_SIZE + pixelCount * (channels + 1) + QOI_PADDING_SIZE);
+    uint8_t *p = out.data();
+
+    // Header
+    WriteBE32(p + 0, QOI_MAGIC);
+    WriteBE32(p + 4, width);
+    WriteBE32(p + 8, height);
+    p[12] = channels;
+    p[13] = QOI_SRGB;
+    p += QOI_HEADER_SIZE;
+
+    // Chunks
+    uint32_t index[64];
+    std::memset(index, 0, sizeof(index));
+
+    std::vector<uint32_t> chunk(1 + QOI_CHUNK_PIXELS); // chunk[0] holds the pixel before the chunk.
+    std::vector<uint8_t> hashes(QOI_CHUNK_PIXELS);
+    uint64_t repeats[QOI_CHUNK_PIXELS / 64];
+
+    uint32_t *px = chunk.data() + 1;
+    chunk[0] = QOI_START_PIXEL;
+    size_t run = 0;
+
+    for(size_t start = 0; start < pixelCount; start += QOI_CHUNK_PIXELS) {
+        const size_t count = std::min<size_t>(QOI_CHUNK_PIXELS, pixelCount - start);
+        const uint8_t *src = pixels + start * channels;
+
+        if(channels == 4) {
+            std::memcpy(px, src, count * 4);
+        }else {
+            for(size_t i = 0; i < count; i++)
+                px[i] = PackPixel(src[i*3 + 0], src[i*3 + 1], src[i*3 + 2], 255);
+        }
+
+        analyse(px, count, hashes.data(), repeats);
+
+        for(size_t i = 0; i < count;) {
+            // Repeats of the previous pixel extend the run, as many at once as
+            // there are consecutive bits set.
+            const uint64_t bits = repeats[i / 64] >> (i % 64);
+
+            if(bits & 1) {
+                const size_t n = (~bits == 0) ? 64 : __builtin_ctzll(~bits);
+                run += n;
+                i += n;
+
+                for(; run >= QOI_MAX_RUN; run -= QOI_MAX_RUN)
+                    *p++ = QOI_OP_RUN | (QOI_MAX_RUN - 1);
+
+                continue;
+            }
+
+            if(run > 0) {
+                *p++ = QOI_OP_RUN | (run - 1);
+                run = 0;
+            }
+
+            const uint32_t cur = px[i];
+            const uint32_t prev = px[i - 1];
+            const uint8_t indexPos = hashes[i];
+            i++;
+
+            if(index[indexPos] == cur) {
+                *p++ = QOI_OP_INDEX | indexPos;
+                continue;
+            }
+
+            index[indexPos] = cur;
+
+            if(PixelA(cur) == PixelA(prev)) {
+                const int8_t vr = PixelR(cur) - PixelR(prev);
+                const int8_t vg = PixelG(cur) - PixelG(prev);
+                const int8_t vb = PixelB(cur) - PixelB(prev);
+
+                const int8_t vgr = vr - vg;
+                const int8_t vgb = vb - vg;
+
+                if( (vr > -3) && (vr < 2) &&
+                    (vg > -3) && (vg < 2) &&
+                    (vb > -3) && (vb < 2)
+                ) {
+                    *p++ = QOI_OP_DIFF | ((vr + 2) << 4) | ((vg + 2) << 2) | (vb + 2);
+                }else if(
+                    (vgr > -9) && (vgr < 8) &&
+                    (vg > -33) && (vg < 32) &&
+                    (vgb > -9) && (vgb < 8)
+                ) {
+                    *p++ = QOI_OP_LUMA | (vg + 32);
+                    *p++ = ((vgr + 8) << 4) | (vgb + 8);
+                }else {
+                    *p++ = QOI_OP_RGB;
+                    *p++ = PixelR(cur);
+                    *p++ = PixelG(cur);
+                    *p++ = PixelB(cur);
+                }
+            }else {
+                *p++ = QOI_OP_RGBA;
+                *p++ = PixelR(cur);
+                *p++ = PixelG(cur);
+                *p++ = PixelB(cur);
+                *p++ = PixelA(cur);
+            }
+        }
+
+        chunk[0] = px[count - 1];
+    }
+
+    if(run > 0) *p++ = QOI_OP_RUN | (run - 1);
+
+    // Padding
+    for(int i = 0; i < QOI_PADDING_SIZE - 1; i++) *p++ = 0x00;
+    *p++ = 0x01;
+
+    out.resize(p - out.data());
+
+    return out;
+}
+
+std::vector<uint8_t> EncodeQOI(const Image &image) {
+    if(image.data == nullptr) return {};
+
+    switch(image.format) {
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8:
+            return EncodeQOI((const uint8_t *)image.data, image.width, image.height, 3);
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8:
+            return EncodeQOI((const uint8_t *)image.data, image.width, image.height, 4);
+        default:
+            break;
+    }
+
+    // Greyscale, 16-bit, etc.
+    Image rgba = ImageCopy(image);
+    ImageFormat(&rgba, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    std::vector<uint8_t> out;
+    if(rgba.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+        out = EncodeQOI((const uint8_t *)rgba.data, rgba.width, rgba.height, 4);
+
+    UnloadImage(rgba);
+
+    return out;
+}
+
+// Decoding
+bool DecodeQOI(const uint8_t *data, size_t size, std::vector<uint8_t> &pixels, int &width, int &height, int &channels) {
+    if((data == nullptr) || (size < QOI_HEADER_SIZE + QOI_PADDING_SIZE)) return false;
+    if(ReadBE32(data) != QOI_MAGIC) return false;
+
+    const uint32_t w = ReadBE32(data + 4);
+    const uint32_t h = ReadBE32(data + 8);
+    const int c = data[12];
+
+    if((w == 0) || (h == 0) || ((c != 3) && (c != 4))) return false;
+    if(h >= QOI_MAX_PIXELS / w) return false;
+
+    const size_t pixelCount = (size_t)w * h;
+    const size_t chunksEnd = size - QOI_PADDING_SIZE;
+
+    pixels.resize(pixelCount * c);
+    uint8_t *out = pixels.data();
+
+    uint32_t index[64];
+    std::memset(index, 0, sizeof(index));
+
+    uint32_t px = QOI_START_PIXEL;
+    size_t p = QOI_HEADER_SIZE;
+    int run = 0;
+
+    for(size_t i = 0; i < pixelCount; i++) {
+        if(run > 0) {
+            run--;
+        }else if(p < chunksEnd) {
+            const uint8_t b1 = data[p++];
+
+            if(b1 == QOI_OP_RGB) {
+                px = PackPixel(data[p], data[p + 1], data[p + 2], PixelA(px));
+                p += 3;
+            }else if(b1 == QOI_OP_RGBA) {
+                px = PackPixel(data[p], data[p + 1], data[p + 2], data[p + 3]);
+                p += 4;
+            }else if((b1 & QOI_MASK_2) == QOI_OP_INDEX) {
+                px = index[b1];
+            }else if((b1 & QOI_MASK_2) == QOI_OP_DIFF) {
+                px = PackPixel(
+                    PixelR(px) + ((b1 >> 4) & 0x03) - 2,
+                    PixelG(px) + ((b1 >> 2) & 0x03) - 2,
+                    PixelB(px) + ((b1 >> 0) & 0x03) - 2,
+                    PixelA(px)
+                );
+            }else if((b1 & QOI_MASK_2) == QOI_OP_LUMA) {
+                const uint8_t b2 = data[p++];
+                const int vg = (b1 & 0x3F) - 32;
+
+                px = PackPixel(
+                    PixelR(px) + vg - 8 + ((b2 >> 4) & 0x0F),
+                    PixelG(px) + vg,
+                    PixelB(px) + vg - 8 + (b2 & 0x0F),
+                    PixelA(px)
+                );
+            }else if((b1 & QOI_MASK_2) == QOI_OP_RUN) {
+                run = (b1 & 0x3F);
+            }
+
+            index[HashPixel(px)] = px;
+        }
+
+        out[0] = PixelR(px);
+        out[1] = PixelG(px);
+        out[2] = PixelB(px);
+        if(c == 4) out[3] = PixelA(px);
+        out += c;
+    }
+
+    width = w;
+    height = h;
+    channels = c;
+
+    return true;
+}
\ No newline at end of file
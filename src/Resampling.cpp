@@ -0,0 +1,150 @@
+#include <GalaMake/Resampling.hpp>
+
+#include <cmath>
+#include <numeric>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define RESAMPLE_SSE2
+#endif
+
+// Channels
+AudioSamples MixAudioChannels(const AudioSamples &audio, unsigned int channels) {
+    if(audio.channels == channels) return audio;
+
+    AudioSamples out;
+    out.channels = channels;
+    out.sampleRate = audio.sampleRate;
+    out.frameCount = audio.frameCount;
+    out.samples.resize((size_t)audio.frameCount * channels);
+
+    for(uint64_t f = 0; f < audio.frameCount; f++) {
+        const float *in = audio.samples.data() + f * audio.channels;
+        float *o = out.samples.data() + f * channels;
+
+        if(channels == 1) {
+            float sum = 0.0f;
+            for(unsigned int c = 0; c < audio.channels; c++) sum += in[c];
+
+            o[0] = sum / audio.channels;
+        }else {
+            for(unsigned int c = 0; c < channels; c++)
+                o[c] = in[std::min(c, audio.channels - 1)];
+        }
+    }
+
+    return out;
+}
+
+// Filter
+struct PolyphaseFilter {
+    unsigned int up = 1, down = 1;
+    unsigned int taps = 0;
+    std::vector<float> coefficients; // 'taps' per phase, 'up' phases.
+};
+
+static double BesselI0(double x) {
+    double sum = 1.0, term = 1.0;
+
+    for(int k = 1; k < 64; k++) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if(term < sum * 1e-12) break;
+    }
+
+    return sum;
+}
+
+static PolyphaseFilter DesignFilter(unsigned int up, unsigned int down) {
+    PolyphaseFilter filter;
+    filter.up = up;
+    filter.down = down;
+
+    // Input samples per side, rounded so every phase is a multiple of 4 long.
+    const double cutoff = std::min(1.0, (double)up / down) * GALAMAKE_RESAMPLE_CUTOFF;
+    const unsigned int halfTaps = ((unsigned int)std::ceil(GALAMAKE_RESAMPLE_ZERO_CROSSINGS / cutoff) + 1) & ~1u;
+
+    filter.taps = halfTaps * 2;
+    filter.coefficients.resize((size_t)up * filter.taps);
+
+    const double windowScale = 1.0 / BesselI0(GALAMAKE_RESAMPLE_KAISER_BETA);
+
+    for(unsigned int p = 0; p < up; p++) {
+        float *phase = filter.coefficients.data() + (size_t)p * filter.taps;
+        double sum = 0.0;
+
+        for(unsigned int k = 0; k < filter.taps; k++) {
+            // Distance, in input samples, from the output sample to tap k's input.
+            const double t = (double)p / up + halfTaps - 1.0 - k;
+            const double x = t / halfTaps;
+
+            double value = 0.0;
+            if(std::abs(x) < 1.0) {
+                const double sinc = (t == 0.0) ? 1.0 : std::sin(M_PI * cutoff * t) / (M_PI * cutoff * t);
+                value = cutoff * sinc * BesselI0(GALAMAKE_RESAMPLE_KAISER_BETA * std::sqrt(1.0 - x * x)) * windowScale;
+            }
+
+            phase[k] = value;
+            sum += value;
+        }
+
+        // Unity gain at DC for every phase.
+        for(unsigned int k = 0; k < filter.taps; k++)
+            phase[k] = phase[k] / sum;
+    }
+
+    return filter;
+}
+
+// Both are 'count' long, a multiple of 4.
+static inline float DotProduct(const float *a, const float *b, unsigned int count) {
+#ifdef RESAMPLE_SSE2
+    __m128 sum = _mm_setzero_ps();
+    for(unsigned int i = 0; i < count; i += 4)
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+
+    float lanes[4];
+    _mm_storeu_ps(lanes, sum);
+
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#else
+    float sum[4] = {};
+    for(unsigned int i = 0; i < count; i += 4)
+        for(int j = 0; j < 4; j++) sum[j] += a[i + j] * b[i + j];
+
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+#endif
+}
+
+// Resampling
+AudioSamples ResampleAudio(const AudioSamples &audio, unsigned int sampleRate) {
+    if(audio.sampleRate == sampleRate) return audio;
+
+    const unsigned int divisor = std::gcd(audio.sampleRate, sampleRate);
+    const PolyphaseFilter filter = DesignFilter(sampleRate / divisor, audio.sampleRate / divisor);
+    const unsigned int halfTaps = filter.taps / 2;
+
+    AudioSamples out;
+    out.channels = audio.channels;
+    out.sampleRate = sampleRate;
+    out.frameCount = (audio.frameCount * filter.up + filter.down - 1) / filter.down;
+    out.samples.resize((size_t)out.frameCount * out.channels);
+
+    // One channel at a time, zero padded so no tap reads outside.
+    std::vector<float> input(audio.frameCount + filter.taps + 1, 0.0f);
+
+    for(unsigned int c = 0; c < audio.channels; c++) {
+        for(uint64_t f = 0; f < audio.frameCount; f++)
+            input[halfTaps + f] = audio.samples[f * audio.channels + c];
+
+        for(uint64_t n = 0; n < out.frameCount; n++) {
+            const uint64_t position = n * filter.down;
+            const uint64_t first = position / filter.up + 1; // Input index of tap 0, after padding.
+            const float *phase = filter.coefficients.data() + (size_t)(position % filter.up) * filter.taps;
+
+            out.samples[n * out.channels + c] = DotProduct(phase, input.data() + first, filter.taps);
+        }
+    }
+
+    return out;
+}
\ No newline at end of file
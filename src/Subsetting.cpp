@@ -0,0 +1,373 @@
+#include <GalaMake/Subsetting.hpp>
+#include <GalaMake/TrueType.hpp>
+
+#include <cstring>
+
+// Tables kept in a subset. Anything else isn't used to draw glyphs.
+static const char *keptTables[] = {
+    "cmap", "head", "hhea", "hmtx", "maxp", "name", "OS/2", "post",
+    "glyf", "loca", "kern", "GPOS", "GDEF", "vhea", "vmtx",
+    "cvt ", "fpgm", "prep", "gasp"
+};
+
+// Byte order
+static uint16_t Get16(const uint8_t *p) {
+    return ((uint16_t)p[0] << 8) | p[1];
+}
+
+static uint32_t Get32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void Put16(std::vector<uint8_t> &out, uint16_t value) {
+    out.push_back(value >> 8);
+    out.push_back(value & 0xFF);
+}
+
+static void Put32(std::vector<uint8_t> &out, uint32_t value) {
+    Put16(out, value >> 16);
+    Put16(out, value & 0xFFFF);
+}
+
+static void Set16(uint8_t *p, uint16_t value) {
+    p[0] = value >> 8;
+    p[1] = value & 0xFF;
+}
+
+static void Set32(uint8_t *p, uint32_t value) {
+    Set16(p, value >> 16);
+    Set16(p + 2, value & 0xFFFF);
+}
+
+static void PadTo4(std::vector<uint8_t> &out) {
+    while(out.size() % 4) out.push_back(0);
+}
+
+static uint32_t GetChecksum(const std::vector<uint8_t> &table) {
+    uint32_t sum = 0;
+    uint8_t word[4];
+
+    for(size_t i = 0; i < table.size(); i += 4) {
+        memset(word, 0, 4);
+        memcpy(word, table.data() + i, std::min<size_t>(4, table.size() - i));
+        sum += Get32(word);
+    }
+
+    return sum;
+}
+
+// Search fields shared by the table directory and 'cmap' format 4.
+static void GetSearchFields(uint16_t count, uint16_t unit, uint16_t &searchRange, uint16_t &entrySelector, uint16_t &rangeShift) {
+    entrySelector = 0;
+    while((2u << entrySelector) <= count) entrySelector++;
+
+    searchRange = (1u << entrySelector) * unit;
+    rangeShift = count * unit - searchRange;
+}
+
+// Glyphs
+struct GlyphLocations {
+    std::vector<uint32_t> offsets; // numGlyphs + 1, into 'glyf'.
+
+    uint32_t GetLength(int glyph) const {
+        return (offsets[glyph + 1] > offsets[glyph]) ? offsets[glyph + 1] - offsets[glyph] : 0;
+    }
+};
+
+static bool ReadLocations(const uint8_t *loca, uint32_t locaLength, bool longOffsets, int glyphCount, uint32_t glyfLength, GlyphLocations &locations) {
+    const size_t entrySize = longOffsets ? 4 : 2;
+    if((size_t)locaLength < (size_t)(glyphCount + 1) * entrySize) return false;
+
+    locations.offsets.resize(glyphCount + 1);
+
+    for(int i = 0; i <= glyphCount; i++) {
+        const uint32_t offset = longOffsets ? Get32(loca + i*4) : (uint32_t)Get16(loca + i*2) * 2;
+        locations.offsets[i] = std::min(offset, glyfLength);
+    }
+
+    return true;
+}
+
+// Marks a composite glyph's components (and theirs) as used.
+static void AddComponents(const uint8_t *glyf, const GlyphLocations &locations, int glyph, std::vector<bool> &used) {
+    std::vector<int> pending = {glyph};
+
+    while(!pending.empty()) {
+        const int g = pending.back();
+        pending.pop_back();
+
+        const uint32_t length = locations.GetLength(g);
+        if(length < 10) continue;
+
+        const uint8_t *data = glyf + locations.offsets[g];
+        if((int16_t)Get16(data) >= 0) continue; // Simple glyph.
+
+        size_t offset = 10;
+        uint16_t flags;
+
+        do {
+            if(offset + 4 > length) break;
+
+            flags = Get16(data + offset);
+            const uint16_t component = Get16(data + offset + 2);
+            offset += 4;
+
+            offset += (flags & 0x0001) ? 4 : 2; // ARG_1_AND_2_ARE_WORDS
+            if(flags & 0x0008) offset += 2;      // WE_HAVE_A_SCALE
+            else if(flags & 0x0040) offset += 4; // WE_HAVE_AN_X_AND_Y_SCALE
+            else if(flags & 0x0080) offset += 8; // WE_HAVE_A_TWO_BY_TWO
+
+            if((component < used.size()) && !used[component]) {
+                used[component] = true;
+                pending.push_back(component);
+            }
+        } while(flags & 0x0020); // MORE_COMPONENTS
+    }
+}
+
+// Character mapping
+static std::vector<uint8_t> BuildCMapFormat4(const std::vector<std::pair<int, int>> &mapping) {
+    struct Segment { uint16_t start, end, delta; };
+    std::vector<Segment> segments;
+
+    for(auto &m : mapping) {
+        if(m.first >= 0xFFFF) break;
+
+        const uint16_t delta = (uint16_t)(m.second - m.first);
+
+        if(!segments.empty() && (segments.back().end + 1 == m.first) && (segments.back().delta == delta))
+            segments.back().end = m.first;
+        else
+            segments.push_back({(uint16_t)m.first, (uint16_t)m.first, delta});
+    }
+
+    segments.push_back({0xFFFF, 0xFFFF, 1});
+
+    const size_t length = 16 + segments.size() * 8;
+    if(length > 0xFFFF) return {};
+
+    uint16_t searchRange, entrySelector, rangeShift;
+    GetSearchFields(segments.size(), 2, searchRange, entrySelector, rangeShift);
+
+    std::vector<uint8_t> out;
+    out.reserve(length);
+
+    Put16(out, 4);
+    Put16(out, length);
+    Put16(out, 0); // Language
+    Put16(out, segments.size() * 2);
+    Put16(out, searchRange);
+    Put16(out, entrySelector);
+    Put16(out, rangeShift);
+
+    for(auto &s : segments) Put16(out, s.end);
+    Put16(out, 0);
+    for(auto &s : segments) Put16(out, s.start);
+    for(auto &s : segments) Put16(out, s.delta);
+    for(size_t i = 0; i < segments.size(); i++) Put16(out, 0);
+
+    return out;
+}
+
+static std::vector<uint8_t> BuildCMapFormat12(const std::vector<std::pair<int, int>> &mapping) {
+    struct Group { uint32_t start, end, glyph; };
+    std::vector<Group> groups;
+
+    for(auto &m : mapping) {
+        if(!groups.empty() && (groups.back().end + 1 == (uint32_t)m.first) && (groups.back().glyph + (m.first - groups.back().start) == (uint32_t)m.second))
+            groups.back().end = m.first;
+        else
+            groups.push_back({(uint32_t)m.first, (uint32_t)m.first, (uint32_t)m.second});
+    }
+
+    std::vector<uint8_t> out;
+    out.reserve(16 + groups.size() * 12);
+
+    Put16(out, 12);
+    Put16(out, 0);
+    Put32(out, 16 + groups.size() * 12);
+    Put32(out, 0); // Language
+    Put32(out, groups.size());
+
+    for(auto &g : groups) {
+        Put32(out, g.start);
+        Put32(out, g.end);
+        Put32(out, g.glyph);
+    }
+
+    return out;
+}
+
+// A Windows BMP subtable where one fits, and a full repertoire one when needed.
+static std::vector<uint8_t> BuildCMap(const std::vector<std::pair<int, int>> &mapping) {
+    std::vector<uint8_t> format4 = BuildCMapFormat4(mapping);
+
+    const bool needsFull = format4.empty() || (!mapping.empty() && (mapping.back().first >= 0xFFFF));
+    std::vector<uint8_t> format12;
+    if(needsFull) format12 = BuildCMapFormat12(mapping);
+
+    const uint16_t subtableCount = (format4.empty() ? 0 : 1) + (needsFull ? 1 : 0);
+
+    std::vector<uint8_t> out;
+    Put16(out, 0);
+    Put16(out, subtableCount);
+
+    uint32_t offset = 4 + subtableCount * 8;
+
+    if(!format4.empty()) {
+        Put16(out, 3); Put16(out, 1); Put32(out, offset);
+        offset += format4.size();
+    }
+    if(needsFull) {
+        Put16(out, 3); Put16(out, 10); Put32(out, offset);
+    }
+
+    out.insert(out.end(), format4.begin(), format4.end());
+    out.insert(out.end(), format12.begin(), format12.end());
+
+    return out;
+}
+
+// Subsetting
+bool SubsetFont(const std::vector<uint8_t> &fontData, const std::vector<int> &codepoints, std::vector<uint8_t> &subset) {
+    TrueTypeFont font;
+    if(!font.Open(fontData.data(), fontData.size())) return false;
+
+    const TrueTypeFont::Table *head = font.GetTable("head");
+    const TrueTypeFont::Table *maxp = font.GetTable("maxp");
+    const TrueTypeFont::Table *loca = font.GetTable("loca");
+    const TrueTypeFont::Table *glyf = font.GetTable("glyf");
+
+    if(!head || !maxp || !loca || !glyf) return false;
+    if((head->length < 54) || (maxp->length < 6)) return false;
+
+    const uint8_t *data = fontData.data();
+    const int glyphCount = font.GetGlyphCount();
+    const bool longOffsets = Get16(data + head->offset + 50) != 0;
+
+    GlyphLocations locations;
+    if(!ReadLocations(data + loca->offset, loca->length, longOffsets, glyphCount, glyf->length, locations))
+        return false;
+
+    // Glyphs in use
+    std::vector<bool> used(glyphCount, false);
+    std::vector<std::pair<int, int>> mapping; // Codepoint to glyph, by codepoint.
+
+    if(glyphCount > 0) used[0] = true;
+
+    for(int codepoint : codepoints) {
+        const int glyph = font.GetGlyphIndex(codepoint);
+        if((glyph <= 0) || (glyph >= glyphCount)) continue;
+
+        mapping.push_back({codepoint, glyph});
+        used[glyph] = true;
+    }
+
+    std::sort(mapping.begin(), mapping.end());
+
+    for(int g = 0; g < glyphCount; g++)
+        if(used[g]) AddComponents(data + glyf->offset, locations, g, used);
+
+    // Glyph data, without the unused glyphs.
+    std::vector<uint8_t> newGlyf;
+    std::vector<uint32_t> newOffsets(glyphCount + 1, 0);
+
+    for(int g = 0; g < glyphCount; g++) {
+        newOffsets[g] = newGlyf.size();
+
+        const uint32_t length = locations.GetLength(g);
+        if(!used[g] || (length == 0)) continue;
+
+        const uint8_t *glyph = data + glyf->offset + locations.offsets[g];
+        newGlyf.insert(newGlyf.end(), glyph, glyph + length);
+        PadTo4(newGlyf);
+    }
+
+    newOffsets[glyphCount] = newGlyf.size();
+
+    // Short offsets (halved) where they reach; every glyph starts 4-byte aligned.
+    const bool newLongOffsets = newGlyf.size() > 0x1FFFE;
+
+    std::vector<uint8_t> newLoca;
+    for(uint32_t offset : newOffsets) {
+        if(newLongOffsets) Put32(newLoca, offset);
+        else Put16(newLoca, offset / 2);
+    }
+
+    // Tables
+    struct OutTable {
+        uint32_t tag;
+        std::vector<uint8_t> data;
+    };
+
+    std::vector<OutTable> tables;
+
+    for(auto &table : font.GetTables()) {
+        bool keep = false;
+        for(auto name : keptTables)
+            if(table.tag == GetTrueTypeTag(name)) { keep = true; break; }
+
+        if(!keep) continue;
+
+        OutTable out = {table.tag, {}};
+
+        if(table.tag == GetTrueTypeTag("glyf")) {
+            out.data = std::move(newGlyf);
+        }else if(table.tag == GetTrueTypeTag("loca")) {
+            out.data = std::move(newLoca);
+        }else if(table.tag == GetTrueTypeTag("cmap")) {
+            out.data = BuildCMap(mapping);
+        }else if((table.tag == GetTrueTypeTag("post")) && (table.length >= 32)) {
+            // Version 3: no glyph names.
+            out.data.assign(data + table.offset, data + table.offset + 32);
+            Set32(out.data.data(), 0x00030000);
+        }else {
+            out.data.assign(data + table.offset, data + table.offset + table.length);
+        }
+
+        if(table.tag == GetTrueTypeTag("head")) {
+            Set32(out.data.data() + 8, 0); // checkSumAdjustment, set below.
+            Set16(out.data.data() + 50, newLongOffsets ? 1 : 0);
+        }
+
+        tables.push_back(std::move(out));
+    }
+
+    std::sort(tables.begin(), tables.end(), [](const OutTable &a, const OutTable &b) { return a.tag < b.tag; });
+
+    // Assemble
+    uint16_t searchRange, entrySelector, rangeShift;
+    GetSearchFields(tables.size(), 16, searchRange, entrySelector, rangeShift);
+
+    subset.clear();
+    Put32(subset, 0x00010000);
+    Put16(subset, tables.size());
+    Put16(subset, searchRange);
+    Put16(subset, entrySelector);
+    Put16(subset, rangeShift);
+
+    uint32_t offset = 12 + tables.size() * 16;
+    size_t headOffset = 0;
+
+    for(auto &table : tables) {
+        if(table.tag == GetTrueTypeTag("head")) headOffset = offset;
+
+        Put32(subset, table.tag);
+        Put32(subset, GetChecksum(table.data));
+        Put32(subset, offset);
+        Put32(subset, table.data.size());
+
+        offset += (table.data.size() + 3) & ~3u;
+    }
+
+    subset.reserve(offset);
+
+    for(auto &table : tables) {
+        subset.insert(subset.end(), table.data.begin(), table.data.end());
+        PadTo4(subset);
+    }
+
+    Set32(subset.data() + headOffset + 8, 0xB1B0AFBA - GetChecksum(subset));
+
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include <GalaMake/Tiling.hpp>
+#include <GalaMake/Utils.hpp>
+
+#include <cstring>
+#include <unordered_map>
+
+static uint64_t HashTile(const RGBAImage &image, int x, int y, int tileSize) {
+    Hasher hasher;
+
+    for(int row = 0; row < tileSize; row++)
+        hasher.Update(image.pixels.data() + ((size_t)(y + row) * image.width + x) * 4, (size_t)tileSize * 4);
+
+    return hasher.Finish();
+}
+
+static bool CompareTiles(const RGBAImage &image, int ax, int ay, int bx, int by, int tileSize) {
+    for(int row = 0; row < tileSize; row++) {
+        const uint8_t *a = image.pixels.data() + ((size_t)(ay + row) * image.width + ax) * 4;
+        const uint8_t *b = image.pixels.data() + ((size_t)(by + row) * image.width + bx) * 4;
+
+        if(memcmp(a, b, (size_t)tileSize * 4) != 0) return false;
+    }
+
+    return true;
+}
+
+RGBAImage DeduplicateTiles(const RGBAImage &image, int tileSize, std::vector<uint16_t> &remap) {
+    RGBAImage out;
+    remap.clear();
+
+    if(tileSize <= 0) return out;
+
+    const int columns = image.width / tileSize, rows = image.height / tileSize;
+    if((columns == 0) || (rows == 0)) return out;
+
+    // Find unique cells; equal hashes are only a match once the bytes agree.
+    std::unordered_map<uint64_t, std::vector<int>> seen; // Hash -> unique tile indices.
+    std::vector<int> unique; // Unique tile index -> original cell.
+
+    for(int cell = 0; cell < columns * rows; cell++) {
+        const int x = (cell % columns) * tileSize, y = (cell / columns) * tileSize;
+        auto &candidates = seen[HashTile(image, x, y, tileSize)];
+
+        int match = -1;
+        for(int u : candidates) {
+            const int ux = (unique[u] % columns) * tileSize, uy = (unique[u] / columns) * tileSize;
+            if(CompareTiles(image, x, y, ux, uy, tileSize)) { match = u; break; }
+        }
+
+        if(match < 0) {
+            if(unique.size() > UINT16_MAX) { remap.clear(); return out; }
+
+            match = unique.size();
+            unique.push_back(cell);
+            candidates.push_back(match);
+        }
+
+        remap.push_back(match);
+    }
+
+    // Compacted texture
+    const int outRows = (unique.size() + columns - 1) / columns;
+
+    out.width = columns * tileSize;
+    out.height = outRows * tileSize;
+    out.pixels.assign((size_t)out.width * out.height * 4, 0x00);
+
+    for(size_t u = 0; u < unique.size(); u++) {
+        const int srcX = (unique[u] % columns) * tileSize, srcY = (unique[u] / columns) * tileSize;
+        const int dstX = (u % columns) * tileSize, dstY = (u / columns) * tileSize;
+
+        for(int row = 0; row < tileSize; row++) {
+            memcpy(
+                out.pixels.data() + ((size_t)(dstY + row) * out.width + dstX) * 4,
+                image.pixels.data() + ((size_t)(srcY + row) * image.width + srcX) * 4,
+                (size_t)tileSize * 4
+            );
+        }
+    }
+
+    return out;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include <GalaMake/Tracing.hpp>
+
+static thread_local std::string t_currentResource;
+
+// Tracer
+void Tracer::Enable() {
+    enabled = true;
+}
+
+bool Tracer::IsEnabled() const {
+    return enabled;
+}
+
+void Tracer::Record(
+    const std::string &name, const std::string &category, const std::string &resource,
+    std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end
+) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const auto [it, inserted] = threadIds.try_emplace(std::this_thread::get_id(), threadIds.size() + 1);
+    events.push_back(Event {name, category, resource, start, end, it->second});
+}
+
+bool Tracer::Save(const std::string &filename) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    json j_events = json::array();
+
+    for(auto &e : events) {
+        json j_event = {
+            {"name", e.name},
+            {"cat",  e.category},
+            {"ph",   "X"},
+            {"ts",   std::chrono::duration<double, std::micro>(e.start - origin).count()},
+            {"dur",  std::chrono::duration<double, std::micro>(e.end - e.start).count()},
+            {"pid",  1},
+            {"tid",  e.threadId}
+        };
+
+        if(!e.resource.empty())
+            j_event["args"] = {{"resource", e.resource}};
+
+        j_events.push_back(j_event);
+    }
+
+    const json j_trace = {
+        {"traceEvents", j_events},
+        {"displayTimeUnit", "ms"}
+    };
+
+    std::ofstream f(filename);
+    if(!f.good()) return false;
+    f << j_trace.dump();
+    f.close();
+
+    return true;
+}
+
+Tracer::Tracer() : origin(std::chrono::steady_clock::now()), enabled(false) {}
+
+Tracer &GetTracer() {
+    static Tracer tracer;
+
+    return tracer;
+}
+
+// TraceSpan
+TraceSpan::TraceSpan(const std::string &name, const std::string &category) : active(GetTracer().IsEnabled()) {
+    if(!active) return;
+
+    this->name = name;
+    this->category = category;
+    start = std::chrono::steady_clock::now();
+
+    if(category == "resource") {
+        parentResource = t_currentResource;
+        t_currentResource = name;
+    }
+}
+
+TraceSpan::~TraceSpan() {
+    if(!active) return;
+
+    if(category == "resource") {
+        t_currentResource = parentResource;
+        GetTracer().Record(name, category, "", start, std::chrono::steady_clock::now());
+    }else {
+        GetTracer().Record(name, category, t_currentResource, start, std::chrono::steady_clock::now());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include <GalaMake/Trimming.hpp>
+#include <GalaMake/Atlas.hpp>
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define TRIM_SSE2
+#endif
+
+bool LoadRGBAImage(const std::string &path, RGBAImage &image) {
+    Image img = LoadImage(path.c_str());
+    if(!img.data) return false;
+
+    if(img.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+        ImageFormat(&img, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    const bool success = (img.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    if(success) {
+        const uint8_t *data = (const uint8_t *)img.data;
+        image.pixels.assign(data, data + (size_t)img.width * img.height * 4);
+        image.width = img.width;
+        image.height = img.height;
+    }
+
+    UnloadImage(img);
+
+    return success;
+}
+
+std::vector<SpriteFrame> GetSpriteFrames(const json &spriteConfig) {
+    std::vector<SpriteFrame> frames;
+
+    for(auto &f : spriteConfig["frames"]) {
+        SpriteFrame frame = {f[0].get<int>(), f[1].get<int>(), f[2].get<int>(), f[3].get<int>()};
+        frame.sourceWidth = frame.width;
+        frame.sourceHeight = frame.height;
+
+        frames.push_back(frame);
+    }
+
+    return frames;
+}
+
+// Alpha scanning
+static inline bool IsOpaque(const uint8_t *pixel) {
+    return pixel[3] != 0;
+}
+
+#ifdef TRIM_SSE2
+// Bit i is set if pixel i (of 4) has non-zero alpha.
+static inline int GetOpaqueMask(const uint8_t *pixels) {
+    const __m128i alphas = _mm_and_si128(_mm_loadu_si128((const __m128i *)pixels), _mm_set1_epi32(0xFF000000));
+
+    return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(alphas, _mm_setzero_si128()))) ^ 0xF;
+}
+#endif
+
+// First and last pixel in a row with non-zero alpha.
+static bool FindOpaqueSpan(const uint8_t *row, int count, int &first, int &last) {
+    first = -1;
+
+    int i = 0;
+#ifdef TRIM_SSE2
+    for(; i + 4 <= count; i += 4) {
+        const int mask = GetOpaqueMask(row + i*4);
+        if(mask) { first = i + __builtin_ctz(mask); break; }
+    }
+#endif
+    if(first < 0) {
+        for(; i < count; i++)
+            if(IsOpaque(row + i*4)) { first = i; break; }
+    }
+
+    if(first < 0) return false;
+
+    int j = count;
+#ifdef TRIM_SSE2
+    for(; j - 4 >= first; j -= 4) {
+        const int mask = GetOpaqueMask(row + (j - 4)*4);
+        if(mask) { last = j - 4 + (31 - __builtin_clz(mask)); return true; }
+    }
+#endif
+    for(j = j - 1; j > first; j--)
+        if(IsOpaque(row + j*4)) break;
+
+    last = j;
+
+    return true;
+}
+
+bool GetOpaqueBounds(const RGBAImage &image, int x, int y, int width, int height, SpriteFrame &bounds) {
+    // Only the part of the rectangle inside the image can hold anything.
+    const int x0 = std::max(x, 0), y0 = std::max(y, 0);
+    const int x1 = std::min(x + width, image.width), y1 = std::min(y + height, image.height);
+
+    int left = INT32_MAX, right = -1, top = -1, bottom = -1;
+
+    for(int row = y0; row < y1; row++) {
+        int first, last;
+        if(!FindOpaqueSpan(image.pixels.data() + ((size_t)row * image.width + x0) * 4, x1 - x0, first, last))
+            continue;
+
+        if(top < 0) top = row;
+        bottom = row;
+
+        left  = std::min(left, first);
+        right = std::max(right, last);
+    }
+
+    if(top < 0) return false;
+
+    bounds.x = x0 + left - x;
+    bounds.y = top - y;
+    bounds.width = right - left + 1;
+    bounds.height = bottom - top + 1;
+
+    return true;
+}
+
+RGBAImage TrimSpriteFrames(const RGBAImage &image, std::vector<SpriteFrame> &frames) {
+    struct TrimmedFrame {
+        SpriteFrame source;
+        SpriteFrame bounds;
+        bool empty;
+        int x = 0, y = 0;
+    };
+
+    // Find bounds (once per distinct frame rectangle)
+    std::vector<TrimmedFrame> trimmed;
+    std::vector<size_t> frameTrims;
+
+    for(auto &frame : frames) {
+        size_t t = 0;
+        for(; t < trimmed.size(); t++) {
+            const SpriteFrame &s = trimmed[t].source;
+            if((s.x == frame.x) && (s.y == frame.y) && (s.width == frame.width) && (s.height == frame.height)) break;
+        }
+
+        if(t == trimmed.size()) {
+            TrimmedFrame tf = {frame, {}, false};
+            tf.empty = !GetOpaqueBounds(image, frame.x, frame.y, frame.width, frame.height, tf.bounds);
+            trimmed.push_back(tf);
+        }
+
+        frameTrims.push_back(t);
+    }
+
+    // Repack, tallest first, keeping to the original width where possible.
+    std::vector<TrimmedFrame *> order;
+    int binWidth = image.width;
+
+    for(auto &tf : trimmed) {
+        if(tf.empty) continue;
+
+        order.push_back(&tf);
+        binWidth = std::max(binWidth, tf.bounds.width + GALAMAKE_TRIM_PADDING);
+    }
+
+    std::stable_sort(order.begin(), order.end(), [](const TrimmedFrame *a, const TrimmedFrame *b) {
+        return a->bounds.height > b->bounds.height;
+    });
+
+    MaxRectsPacker packer(binWidth, INT16_MAX);
+
+    RGBAImage out;
+
+    for(auto tf : order) {
+        if(!packer.Insert(tf->bounds.width + GALAMAKE_TRIM_PADDING, tf->bounds.height + GALAMAKE_TRIM_PADDING, tf->x, tf->y))
+            return out;
+    }
+
+    packer.GetUsedSize(out.width, out.height);
+    out.width = std::max(out.width - GALAMAKE_TRIM_PADDING, 1);
+    out.height = std::max(out.height - GALAMAKE_TRIM_PADDING, 1);
+    out.pixels.assign((size_t)out.width * out.height * 4, 0x00);
+
+    for(auto tf : order) {
+        const int srcX = tf->source.x + tf->bounds.x, srcY = tf->source.y + tf->bounds.y;
+
+        for(int row = 0; row < tf->bounds.height; row++) {
+            memcpy(
+                out.pixels.data() + ((size_t)(tf->y + row) * out.width + tf->x) * 4,
+                image.pixels.data() + ((size_t)(srcY + row) * image.width + srcX) * 4,
+                (size_t)tf->bounds.width * 4
+            );
+        }
+    }
+
+    // Update frames
+    for(size_t i = 0; i < frames.size(); i++) {
+        const TrimmedFrame &tf = trimmed[frameTrims[i]];
+        SpriteFrame &frame = frames[i];
+
+        frame.sourceWidth = frame.width;
+        frame.sourceHeight = frame.height;
+
+        if(tf.empty) {
+            frame = {0, 0, 0, 0, 0, 0, frame.sourceWidth, frame.sourceHeight};
+            continue;
+        }
+
+        frame.x = tf.x;
+        frame.y = tf.y;
+        frame.width = tf.bounds.width;
+        frame.height = tf.bounds.height;
+        frame.offsetX = tf.bounds.x;
+        frame.offsetY = tf.bounds.y;
+    }
+
+    return out;
+}
\ No newline at end of file
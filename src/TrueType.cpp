@@ -0,0 +1,544 @@
+#include <GalaMake/TrueType.hpp>
+
+uint32_t GetTrueTypeTag(const char *tag) {
+    return ((uint32_t)(uint8_t)tag[0] << 24) | ((uint32_t)(uint8_t)tag[1] << 16) | ((uint32_t)(uint8_t)tag[2] << 8) | (uint32_t)(uint8_t)tag[3];
+}
+
+// Reading
+bool TrueTypeFont::Has(size_t offset, size_t count) const {
+    return (offset <= size) && (count <= size - offset);
+}
+
+uint16_t TrueTypeFont::U16(size_t offset) const {
+    if(!Has(offset, 2)) return 0;
+
+    return ((uint16_t)data[offset] << 8) | data[offset + 1];
+}
+
+uint32_t TrueTypeFont::U32(size_t offset) const {
+    if(!Has(offset, 4)) return 0;
+
+    return ((uint32_t)data[offset] << 24) | ((uint32_t)data[offset + 1] << 16) | ((uint32_t)data[offset + 2] << 8) | data[offset + 3];
+}
+
+bool TrueTypeFont::Open(const uint8_t *data, size_t size) {
+    this->data = data;
+    this->size = size;
+    tables.clear();
+    cmapOffset = 0;
+    cmapFormat = 0;
+    kernLookups.clear();
+
+    const uint32_t version = U32(0);
+    if((version != 0x00010000) && (version != GetTrueTypeTag("OTTO")) && (version != GetTrueTypeTag("true")))
+        return false;
+
+    const uint16_t tableCount = U16(4);
+    if(!Has(12, (size_t)tableCount * 16)) return false;
+
+    for(uint16_t i = 0; i < tableCount; i++) {
+        const size_t record = 12 + (size_t)i * 16;
+        const Table table = {U32(record), U32(record + 8), U32(record + 12)};
+
+        if(!Has(table.offset, table.length)) return false;
+        tables.push_back(table);
+    }
+
+    FindCMap();
+    FindKernLookups();
+
+    return true;
+}
+
+const std::vector<TrueTypeFont::Table> &TrueTypeFont::GetTables() const {
+    return tables;
+}
+
+const TrueTypeFont::Table *TrueTypeFont::GetTable(const char *tag) const {
+    const uint32_t t = GetTrueTypeTag(tag);
+
+    for(auto &table : tables)
+        if(table.tag == t) return &table;
+
+    return nullptr;
+}
+
+// Character mapping
+void TrueTypeFont::FindCMap() {
+    const Table *cmap = GetTable("cmap");
+    if(!cmap) return;
+
+    int bestScore = 0;
+    const uint16_t subtableCount = U16(cmap->offset + 2);
+
+    for(uint16_t i = 0; i < subtableCount; i++) {
+        const size_t record = cmap->offset + 4 + (size_t)i * 8;
+        const uint16_t platform = U16(record), encoding = U16(record + 2);
+        const uint32_t offset = cmap->offset + U32(record + 4);
+        const uint16_t format = U16(offset);
+
+        const bool unicode = (platform == 0) || ((platform == 3) && ((encoding == 1) || (encoding == 10)));
+        if(!unicode) continue;
+
+        // Full Unicode (format 12) beats the Basic Multilingual Plane (format 4).
+        const int score = (format == 12) ? 2 : (format == 4) ? 1 : 0;
+
+        if(score > bestScore) {
+            bestScore = score;
+            cmapOffset = offset;
+            cmapFormat = format;
+        }
+    }
+}
+
+int TrueTypeFont::GetGlyphIndex(int codepoint) const {
+    if(codepoint < 0) return 0;
+
+    if(cmapFormat == 4) {
+        if(codepoint > 0xFFFF) return 0;
+
+        const size_t segCount = U16(cmapOffset + 6) / 2;
+        const size_t endCodes = cmapOffset + 14;
+        const size_t startCodes = endCodes + segCount*2 + 2;
+        const size_t idDeltas = startCodes + segCount*2;
+        const size_t idRangeOffsets = idDeltas + segCount*2;
+
+        // First segment ending at or after the codepoint.
+        size_t low = 0, high = segCount;
+        while(low < high) {
+            const size_t mid = (low + high) / 2;
+            if(U16(endCodes + mid*2) < codepoint) low = mid + 1;
+            else                                  high = mid;
+        }
+
+        if(low >= segCount) return 0;
+
+        const uint16_t start = U16(startCodes + low*2);
+        if(start > codepoint) return 0;
+
+        const uint16_t delta = U16(idDeltas + low*2);
+        const uint16_t rangeOffset = U16(idRangeOffsets + low*2);
+
+        if(rangeOffset == 0) return (codepoint + delta) & 0xFFFF;
+
+        const uint16_t glyph = U16(idRangeOffsets + low*2 + rangeOffset + (codepoint - start)*2);
+
+        return (glyph == 0) ? 0 : ((glyph + delta) & 0xFFFF);
+    }
+
+    if(cmapFormat == 12) {
+        const uint32_t groupCount = U32(cmapOffset + 12);
+        const size_t groups = cmapOffset + 16;
+
+        uint32_t low = 0, high = groupCount;
+        while(low < high) {
+            const uint32_t mid = low + (high - low) / 2;
+            const size_t group = groups + (size_t)mid * 12;
+
+            if(U32(group + 4) < (uint32_t)codepoint)   low = mid + 1;
+            else if(U32(group) > (uint32_t)codepoint)  high = mid;
+            else                                       return U32(group + 8) + (codepoint - U32(group));
+        }
+    }
+
+    return 0;
+}
+
+int TrueTypeFont::GetGlyphCount() const {
+    const Table *maxp = GetTable("maxp");
+
+    return maxp ? U16(maxp->offset + 4) : 0;
+}
+
+float TrueTypeFont::GetScaleForPixelHeight(float pixelHeight) const {
+    const Table *hhea = GetTable("hhea");
+    if(!hhea) return 0.0f;
+
+    const int height = (int16_t)U16(hhea->offset + 4) - (int16_t)U16(hhea->offset + 6);
+
+    return (height > 0) ? (pixelHeight / height) : 0.0f;
+}
+
+// Kerning
+void TrueTypeFont::FindKernLookups() {
+    const Table *gpos = GetTable("GPOS");
+    if(!gpos) return;
+
+    const size_t featureList = gpos->offset + U16(gpos->offset + 6);
+    const size_t lookupList = gpos->offset + U16(gpos->offset + 8);
+    const uint16_t lookupCount = U16(lookupList);
+
+    // Lookups used by any 'kern' feature, in lookup order.
+    std::vector<bool> used(lookupCount, false);
+
+    const uint16_t featureCount = U16(featureList);
+    for(uint16_t i = 0; i < featureCount; i++) {
+        const size_t record = featureList + 2 + (size_t)i * 6;
+        if(U32(record) != GetTrueTypeTag("kern")) continue;
+
+        const size_t feature = featureList + U16(record + 4);
+        const uint16_t indexCount = U16(feature + 2);
+
+        for(uint16_t j = 0; j < indexCount; j++) {
+            const uint16_t index = U16(feature + 4 + (size_t)j * 2);
+            if(index < lookupCount) used[index] = true;
+        }
+    }
+
+    for(uint16_t i = 0; i < lookupCount; i++) {
+        if(!used[i]) continue;
+
+        const size_t lookup = lookupList + U16(lookupList + 2 + (size_t)i * 2);
+        const uint16_t type = U16(lookup);
+        const uint16_t subtableCount = U16(lookup + 4);
+
+        std::vector<uint32_t> subtables;
+
+        for(uint16_t j = 0; j < subtableCount; j++) {
+            size_t subtable = lookup + U16(lookup + 6 + (size_t)j * 2);
+
+            // Extension subtables point on to the real one.
+            if(type == 9) {
+                if(U16(subtable + 2) != 2) continue;
+                subtable += U32(subtable + 4);
+            }else if(type != 2) {
+                continue;
+            }
+
+            if(Has(subtable, 10)) subtables.push_back(subtable);
+        }
+
+        if(!subtables.empty()) kernLookups.push_back(std::move(subtables));
+    }
+}
+
+int TrueTypeFont::GetCoverageIndex(uint32_t coverageOffset, int glyph) const {
+    const uint16_t format = U16(coverageOffset);
+    const uint16_t count = U16(coverageOffset + 2);
+
+    int low = 0, high = count;
+
+    if(format == 1) {
+        while(low < high) {
+            const int mid = (low + high) / 2;
+            const uint16_t g = U16(coverageOffset + 4 + (size_t)mid * 2);
+
+            if(g < glyph)      low = mid + 1;
+            else if(g > glyph) high = mid;
+            else               return mid;
+        }
+    }else if(format == 2) {
+        while(low < high) {
+            const int mid = (low + high) / 2;
+            const size_t range = coverageOffset + 4 + (size_t)mid * 6;
+
+            if(U16(range + 2) < glyph)  low = mid + 1;
+            else if(U16(range) > glyph) high = mid;
+            else                        return U16(range + 4) + (glyph - U16(range));
+        }
+    }
+
+    return -1;
+}
+
+// Covered glyphs (with their coverage indices) which are also wanted.
+std::vector<std::pair<int, int>> TrueTypeFont::GetCoveredGlyphs(uint32_t coverageOffset, const std::vector<bool> &wanted) const {
+    const uint16_t format = U16(coverageOffset);
+    const uint16_t count = U16(coverageOffset + 2);
+
+    std::vector<std::pair<int, int>> covered;
+
+    if(format == 1) {
+        for(int i = 0; i < count; i++) {
+            const uint16_t g = U16(coverageOffset + 4 + (size_t)i * 2);
+            if(wanted[g]) covered.push_back({g, i});
+        }
+    }else if(format == 2) {
+        for(int i = 0; i < count; i++) {
+            const size_t range = coverageOffset + 4 + (size_t)i * 6;
+            const uint16_t start = U16(range), end = U16(range + 2), index = U16(range + 4);
+
+            for(int g = start; g <= end; g++)
+                if(wanted[g]) covered.push_back({g, index + (g - start)});
+        }
+    }
+
+    return covered;
+}
+
+int TrueTypeFont::GetGlyphClass(uint32_t classDefOffset, int glyph) const {
+    const uint16_t format = U16(classDefOffset);
+
+    if(format == 1) {
+        const uint16_t start = U16(classDefOffset + 2);
+        const uint16_t count = U16(classDefOffset + 4);
+
+        if((glyph >= start) && (glyph < start + count))
+            return U16(classDefOffset + 6 + (size_t)(glyph - start) * 2);
+    }else if(format == 2) {
+        int low = 0, high = U16(classDefOffset + 2);
+
+        while(low < high) {
+            const int mid = (low + high) / 2;
+            const size_t range = classDefOffset + 4 + (size_t)mid * 6;
+
+            if(U16(range + 2) < glyph)  low = mid + 1;
+            else if(U16(range) > glyph) high = mid;
+            else                        return U16(range + 4);
+        }
+    }
+
+    return 0;
+}
+
+static int GetValueRecordSize(uint16_t valueFormat) {
+    return __builtin_popcount(valueFormat & 0xFF) * 2;
+}
+
+// Byte offset of XAdvance in a value record (only valid if it has one).
+static int GetXAdvanceOffset(uint16_t valueFormat) {
+    return __builtin_popcount(valueFormat & 0x3) * 2;
+}
+
+bool TrueTypeFont::GetPairAdjustment(uint32_t subtableOffset, int first, int second, int &adjustment) const {
+    const uint16_t format = U16(subtableOffset);
+    const int coverageIndex = GetCoverageIndex(subtableOffset + U16(subtableOffset + 2), first);
+    if(coverageIndex < 0) return false;
+
+    const uint16_t valueFormat1 = U16(subtableOffset + 4);
+    const uint16_t valueFormat2 = U16(subtableOffset + 6);
+    const size_t recordSize = GetValueRecordSize(valueFormat1) + GetValueRecordSize(valueFormat2);
+
+    if(format == 1) {
+        if(coverageIndex >= U16(subtableOffset + 8)) return false;
+
+        const size_t pairSet = subtableOffset + U16(subtableOffset + 10 + (size_t)coverageIndex * 2);
+        const size_t pairSize = 2 + recordSize;
+
+        int low = 0, high = U16(pairSet);
+        while(low < high) {
+            const int mid = (low + high) / 2;
+            const size_t record = pairSet + 2 + (size_t)mid * pairSize;
+            const uint16_t g = U16(record);
+
+            if(g < second)      low = mid + 1;
+            else if(g > second) high = mid;
+            else {
+                adjustment = (valueFormat1 & 0x4) ? (int16_t)U16(record + 2 + GetXAdvanceOffset(valueFormat1)) : 0;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    if(format == 2) {
+        const int class1 = GetGlyphClass(subtableOffset + U16(subtableOffset + 8), first);
+        const int class2 = GetGlyphClass(subtableOffset + U16(subtableOffset + 10), second);
+        const uint16_t class1Count = U16(subtableOffset + 12);
+        const uint16_t class2Count = U16(subtableOffset + 14);
+
+        if((class1 >= class1Count) || (class2 >= class2Count)) return false;
+
+        const size_t record = subtableOffset + 16 + ((size_t)class1 * class2Count + class2) * recordSize;
+        adjustment = (valueFormat1 & 0x4) ? (int16_t)U16(record + GetXAdvanceOffset(valueFormat1)) : 0;
+
+        return true;
+    }
+
+    return false;
+}
+
+int TrueTypeFont::GetKernTableKerning(int first, int second) const {
+    const Table *kern = GetTable("kern");
+    if(!kern || (U16(kern->offset) != 0)) return 0; // Only the original (Microsoft) version.
+
+    const uint32_t key = ((uint32_t)first << 16) | (uint32_t)second;
+    const uint16_t subtableCount = U16(kern->offset + 2);
+
+    int total = 0;
+    size_t subtable = kern->offset + 4;
+
+    for(uint16_t i = 0; i < subtableCount; i++) {
+        const uint16_t length = U16(subtable + 2);
+        const uint16_t coverage = U16(subtable + 4);
+
+        // Format 0, horizontal, neither minimum values nor cross-stream.
+        if(((coverage >> 8) == 0) && ((coverage & 0x7) == 0x1)) {
+            int low = 0, high = U16(subtable + 6);
+
+            while(low < high) {
+                const int mid = (low + high) / 2;
+                const size_t pair = subtable + 14 + (size_t)mid * 6;
+                const uint32_t k = U32(pair);
+
+                if(k < key)      low = mid + 1;
+                else if(k > key) high = mid;
+                else             { total += (int16_t)U16(pair + 4); break; }
+            }
+        }
+
+        if(length == 0) break;
+        subtable += length;
+    }
+
+    return total;
+}
+
+int TrueTypeFont::GetKerning(int firstGlyph, int secondGlyph) const {
+    if(kernLookups.empty()) return GetKernTableKerning(firstGlyph, secondGlyph);
+
+    int total = 0;
+
+    for(auto &lookup : kernLookups) {
+        // Within a lookup, the first subtable which applies is the only one.
+        for(auto subtable : lookup) {
+            int adjustment = 0;
+            if(GetPairAdjustment(subtable, firstGlyph, secondGlyph, adjustment)) {
+                total += adjustment;
+                break;
+            }
+        }
+    }
+
+    return total;
+}
+
+// Adds one subtable's adjustments between wanted glyphs. As in GetKerning,
+// only the first subtable of a lookup which applies to a pair counts: pairs
+// (or, for class based subtables, every pair after a covered first glyph)
+// are claimed as they are seen.
+void TrueTypeFont::AddPairAdjustments(uint32_t subtableOffset, const std::vector<int> &glyphs, const std::vector<bool> &wanted,
+    std::set<int> &claimedFirsts, std::set<uint32_t> &claimedPairs, std::map<uint32_t, int> &pairs) const {
+    const uint16_t format = U16(subtableOffset);
+    const uint16_t valueFormat1 = U16(subtableOffset + 4);
+    const uint16_t valueFormat2 = U16(subtableOffset + 6);
+    const size_t recordSize = GetValueRecordSize(valueFormat1) + GetValueRecordSize(valueFormat2);
+    const bool hasAdvance = (valueFormat1 & 0x4) != 0;
+
+    const auto covered = GetCoveredGlyphs(subtableOffset + U16(subtableOffset + 2), wanted);
+
+    if(format == 1) {
+        const uint16_t pairSetCount = U16(subtableOffset + 8);
+        const size_t pairSize = 2 + recordSize;
+
+        for(auto &[first, coverageIndex] : covered) {
+            if((coverageIndex >= pairSetCount) || (claimedFirsts.count(first) > 0)) continue;
+
+            const size_t pairSet = subtableOffset + U16(subtableOffset + 10 + (size_t)coverageIndex * 2);
+            const uint16_t pairCount = U16(pairSet);
+
+            for(uint16_t i = 0; i < pairCount; i++) {
+                const size_t record = pairSet + 2 + (size_t)i * pairSize;
+                const uint16_t second = U16(record);
+                if(!wanted[second]) continue;
+
+                const uint32_t key = ((uint32_t)first << 16) | second;
+                if(!claimedPairs.insert(key).second) continue;
+
+                const int adjustment = hasAdvance ? (int16_t)U16(record + 2 + GetXAdvanceOffset(valueFormat1)) : 0;
+                if(adjustment != 0) pairs[key] += adjustment;
+            }
+        }
+    }else if(format == 2) {
+        const uint32_t classDef1 = subtableOffset + U16(subtableOffset + 8);
+        const uint32_t classDef2 = subtableOffset + U16(subtableOffset + 10);
+        const uint16_t class1Count = U16(subtableOffset + 12);
+        const uint16_t class2Count = U16(subtableOffset + 14);
+
+        // Wanted glyphs by their second class.
+        std::vector<std::vector<int>> class2Glyphs(class2Count);
+        for(int g : glyphs) {
+            const int c = GetGlyphClass(classDef2, g);
+            if(c < class2Count) class2Glyphs[c].push_back(g);
+        }
+
+        for(auto &[first, coverageIndex] : covered) {
+            if(claimedFirsts.count(first) > 0) continue;
+
+            const int class1 = GetGlyphClass(classDef1, first);
+            if(class1 >= class1Count) continue;
+
+            for(int class2 = 0; class2 < class2Count; class2++) {
+                const size_t record = subtableOffset + 16 + ((size_t)class1 * class2Count + class2) * recordSize;
+                const int adjustment = hasAdvance ? (int16_t)U16(record + GetXAdvanceOffset(valueFormat1)) : 0;
+                if(adjustment == 0) continue;
+
+                for(int second : class2Glyphs[class2]) {
+                    const uint32_t key = ((uint32_t)first << 16) | (uint32_t)second;
+                    if(claimedPairs.count(key) == 0) pairs[key] += adjustment;
+                }
+            }
+
+            claimedFirsts.insert(first);
+        }
+    }
+}
+
+void TrueTypeFont::AddKernTablePairs(const std::vector<bool> &wanted, std::map<uint32_t, int> &pairs) const {
+    const Table *kern = GetTable("kern");
+    if(!kern || (U16(kern->offset) != 0)) return; // Only the original (Microsoft) version.
+
+    const uint16_t subtableCount = U16(kern->offset + 2);
+    size_t subtable = kern->offset + 4;
+
+    for(uint16_t i = 0; i < subtableCount; i++) {
+        const uint16_t length = U16(subtable + 2);
+        const uint16_t coverage = U16(subtable + 4);
+
+        // Format 0, horizontal, neither minimum values nor cross-stream.
+        if(((coverage >> 8) == 0) && ((coverage & 0x7) == 0x1)) {
+            const uint16_t pairCount = U16(subtable + 6);
+
+            for(uint16_t j = 0; j < pairCount; j++) {
+                const size_t pair = subtable + 14 + (size_t)j * 6;
+                const uint32_t key = U32(pair);
+                const int16_t amount = (int16_t)U16(pair + 4);
+
+                if(wanted[key >> 16] && wanted[key & 0xFFFF] && (amount != 0))
+                    pairs[key] += amount;
+            }
+        }
+
+        if(length == 0) break;
+        subtable += length;
+    }
+}
+
+std::map<uint32_t, int> TrueTypeFont::GetKerningPairs(const std::vector<int> &glyphs) const {
+    std::vector<bool> wanted(0x10000, false);
+    std::vector<int> unique;
+
+    for(int g : glyphs) {
+        if((g < 0) || (g > 0xFFFF) || wanted[g]) continue;
+
+        wanted[g] = true;
+        unique.push_back(g);
+    }
+
+    std::map<uint32_t, int> pairs;
+
+    if(kernLookups.empty()) {
+        AddKernTablePairs(wanted, pairs);
+    }else {
+        for(auto &lookup : kernLookups) {
+            std::set<int> claimedFirsts;
+            std::set<uint32_t> claimedPairs;
+
+            for(auto subtable : lookup)
+                AddPairAdjustments(subtable, unique, wanted, claimedFirsts, claimedPairs, pairs);
+        }
+    }
+
+    // Adjustments from several lookups may cancel out.
+    for(auto it = pairs.begin(); it != pairs.end();) {
+        if(it->second == 0) it = pairs.erase(it);
+        else                ++it;
+    }
+
+    return pairs;
+}
+
+bool TrueTypeFont::HasKerning() const {
+    return !kernLookups.empty() || (GetTable("kern") != nullptr);
+}
\ No newline at end of file
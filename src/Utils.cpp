@@ -1,18 +1,101 @@
 #include <GalaMake/Utils.hpp>
+#include <cstring>
 
 // Timer
 void Timer::Start() {
-    clock_start = clock();
+    clock_start = std::chrono::steady_clock::now();
 }
 
 double Timer::Stop() {
-    clock_end = clock();
+    clock_end = std::chrono::steady_clock::now();
 
-    return (clock_end - clock_start) / (double)CLOCKS_PER_SEC;
+    return std::chrono::duration<double>(clock_end - clock_start).count();
 }
 
 Timer::Timer() {}
 
+// Hashing
+static inline uint64_t HashFinalise(uint64_t v) {
+    v ^= v >> 33;
+    v *= 0xFF51AFD7ED558CCDULL;
+    v ^= v >> 33;
+    v *= 0xC4CEB9FE1A85EC53ULL;
+    v ^= v >> 33;
+
+    return v;
+}
+
+void Hasher::Mix(uint64_t word) {
+    state ^= HashFinalise(word);
+    state = (state << 31) | (state >> 33);
+    state *= 0x9E3779B97F4A7C15ULL;
+}
+
+void Hasher::Update(const void *data, size_t size) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    length += size;
+
+    // Finish off a partial word from the previous update.
+    if(tailSize > 0) {
+        const size_t count = std::min(size, 8 - tailSize);
+        std::memcpy(tail + tailSize, bytes, count);
+        tailSize += count;
+        bytes += count;
+        size -= count;
+
+        if(tailSize < 8) return;
+
+        uint64_t word;
+        std::memcpy(&word, tail, 8);
+        Mix(word);
+        tailSize = 0;
+    }
+
+    while(size >= 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes, 8);
+        Mix(word);
+        bytes += 8;
+        size -= 8;
+    }
+
+    std::memcpy(tail, bytes, size);
+    tailSize = size;
+}
+
+uint64_t Hasher::Finish() const {
+    uint64_t word = 0;
+    std::memcpy(&word, tail, tailSize);
+
+    return HashFinalise(state ^ HashFinalise(word ^ length));
+}
+
+Hasher::Hasher(uint64_t seed) : state(seed ^ 0x2545F4914F6CDD1DULL), length(0), tail{}, tailSize(0) {}
+
+uint64_t HashBytes(const void *data, size_t size, uint64_t seed) {
+    Hasher hasher(seed);
+    hasher.Update(data, size);
+
+    return hasher.Finish();
+}
+
+bool HashFile(const std::string &path, uint64_t &hash) {
+    std::ifstream f(path, std::ios::binary);
+    if(!f.good()) return false;
+
+    Hasher hasher;
+    std::vector<char> buffer(1 << 16);
+
+    while(f) {
+        f.read(buffer.data(), buffer.size());
+        hasher.Update(buffer.data(), f.gcount());
+    }
+
+    hash = hasher.Finish();
+
+    return true;
+}
+
 // Etc..
 std::vector<std::string> ScanResources(const json &buildConfig, bool jsonCheck) {
     std::vector<std::string> out;
@@ -44,7 +127,18 @@ std::vector<std::string> ScanResources(const json &buildConfig, bool jsonCheck)
 }
 
 std::pair<std::string, std::string> SplitResourceURI(const std::string &uri) {
-    const size_t colonPos = uri.find_first_of(':');
+    // URIs with spaces are quoted by ScanResources().
+    const bool quoted = (uri.size() >= 2) && (uri.front() == '"') && (uri.back() == '"');
+    const std::string bareURI = quoted ? uri.substr(1, uri.size() - 2) : uri;
+
+    const size_t colonPos = bareURI.find_first_of(':');
+
+    return {bareURI.substr(0, colonPos), bareURI.substr(colonPos + 1)};
+}
+
+std::string GetResourceTypeString(ResourceType type) {
+    for(auto &[typeStr, resType] : g_typeStrs)
+        if(resType == type) return typeStr;
 
-    return {uri.substr(0, colonPos), uri.substr(colonPos + 1)};
+    return "unknown";
 }
\ No newline at end of file
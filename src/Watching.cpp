@@ -0,0 +1,137 @@
+#include <GalaMake/Watching.hpp>
+#include <GalaMake/Paths.hpp>
+#include <GalaMake/Utils.hpp>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+
+#define WATCH_RESOURCE_MASK (IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM)
+#define WATCH_ASSET_MASK    (IN_CREATE | IN_MOVED_TO | IN_ONLYDIR)
+
+void WorkspaceWatcher::AddWatch(const std::string &path, const WatchTarget &target) {
+    if(watchedPaths.count(path) > 0) return;
+
+    const uint32_t mask = target.resourceName.empty() ? WATCH_ASSET_MASK : WATCH_RESOURCE_MASK;
+    const int wd = inotify_add_watch(fd, path.c_str(), mask);
+    if(wd < 0) return;
+
+    targets[wd] = target;
+    targetPaths[wd] = path;
+    watchedPaths.insert(path);
+}
+
+void WorkspaceWatcher::AddAssetDirectory(ResourceType type) {
+    const std::string dir = GetResourceDirectories(buildConfig, type).inputPath;
+    if(!std::filesystem::is_directory(dir)) return;
+
+    AddWatch(dir, WatchTarget {type, ""});
+
+    for(auto &p : std::filesystem::directory_iterator(dir)) {
+        if(!p.is_directory()) continue;
+
+        const std::string resName = p.path().filename().string();
+        AddWatch(GenResourcePaths(buildConfig, type, resName).inputPath, WatchTarget {type, resName});
+    }
+}
+
+bool WorkspaceWatcher::Start(const json &buildConfig) {
+    this->buildConfig = buildConfig;
+
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(fd < 0) return false;
+
+    for(auto &[typeStr, resType] : g_typeStrs)
+        AddAssetDirectory(resType);
+
+    return !targets.empty();
+}
+
+bool WorkspaceWatcher::ReadEvents(std::set<std::string> &changed) {
+    alignas(struct inotify_event) char buffer[16384];
+    bool gotEvents = false;
+
+    while(true) {
+        const ssize_t length = read(fd, buffer, sizeof(buffer));
+        if(length <= 0) break;
+
+        for(ssize_t offset = 0; offset < length;) {
+            const auto *event = (const struct inotify_event *)(buffer + offset);
+            offset += sizeof(struct inotify_event) + event->len;
+
+            if(targets.count(event->wd) == 0) continue;
+            const WatchTarget target = targets[event->wd];
+            const std::string name = (event->len > 0) ? event->name : "";
+
+            // Watch removed (e.g. the directory was deleted): forget it, so
+            // the directory is watched again if it comes back.
+            if(event->mask & IN_IGNORED) {
+                watchedPaths.erase(targetPaths[event->wd]);
+                targetPaths.erase(event->wd);
+                targets.erase(event->wd);
+                continue;
+            }
+
+            if(target.resourceName.empty()) {
+                // New resource directory: start watching it.
+                if(!(event->mask & IN_ISDIR) || name.empty()) continue;
+
+                AddWatch(GenResourcePaths(buildConfig, target.type, name).inputPath, WatchTarget {target.type, name});
+                changed.insert(GetResourceTypeString(target.type) + ":" + name);
+            }else {
+                if(event->mask & IN_ISDIR) continue;
+
+                changed.insert(GetResourceTypeString(target.type) + ":" + target.resourceName);
+            }
+
+            gotEvents = true;
+        }
+    }
+
+    return gotEvents;
+}
+
+std::vector<std::string> WorkspaceWatcher::WaitForChanges(int debounceMs) {
+    std::set<std::string> changed;
+    struct pollfd pfd = {fd, POLLIN, 0};
+
+    // Wait for the first change...
+    while(changed.empty()) {
+        if(poll(&pfd, 1, -1) < 0) return {};
+        ReadEvents(changed);
+    }
+
+    // ...then let the burst of writes settle.
+    while(poll(&pfd, 1, debounceMs) > 0)
+        ReadEvents(changed);
+
+    return std::vector<std::string>(changed.begin(), changed.end());
+}
+
+WorkspaceWatcher::~WorkspaceWatcher() {
+    if(fd >= 0) close(fd);
+}
+
+#else
+
+void WorkspaceWatcher::AddWatch(const std::string &path, const WatchTarget &target) {}
+void WorkspaceWatcher::AddAssetDirectory(ResourceType type) {}
+bool WorkspaceWatcher::ReadEvents(std::set<std::string> &changed) { return false; }
+
+bool WorkspaceWatcher::Start(const json &buildConfig) {
+    return false;
+}
+
+std::vector<std::string> WorkspaceWatcher::WaitForChanges(int debounceMs) {
+    return {};
+}
+
+WorkspaceWatcher::~WorkspaceWatcher() {}
+
+#endif
+
+WorkspaceWatcher::WorkspaceWatcher() {}
\ No newline at end of file
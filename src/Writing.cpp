@@ -0,0 +1,178 @@
+#include <GalaMake/Writing.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <climits>
+#include <cerrno>
+
+#ifdef __linux__
+#include <linux/fs.h>
+#endif
+
+bool FileWriter::WriteAll(const uint8_t *data, size_t size) {
+    while(size > 0) {
+        const ssize_t written = write(fd, data, size);
+
+        if(written < 0) {
+            if(errno == EINTR) continue;
+            return false;
+        }
+
+        data += written;
+        size -= written;
+    }
+
+    return true;
+}
+
+bool FileWriter::CopyFrom(int inFd, size_t size) {
+#ifdef __linux__
+    // Let the kernel move the bytes (possibly without touching them at all).
+    while(size > 0) {
+        const ssize_t copied = copy_file_range(inFd, nullptr, fd, nullptr, size, 0);
+
+        if(copied < 0) {
+            if(errno == EINTR) continue;
+            if((errno == EXDEV) || (errno == ENOSYS) || (errno == EINVAL) || (errno == EOPNOTSUPP)) break;
+            return false;
+        }
+
+        if(copied == 0) return false; // File shrank since its size was taken.
+        size -= copied;
+    }
+
+    if(size == 0) return true;
+#endif
+
+    // By hand, for when the kernel can't.
+    std::vector<uint8_t> buffer(std::min<size_t>(size, GALAMAKE_WRITE_COPY_SIZE));
+
+    while(size > 0) {
+        const ssize_t got = read(inFd, buffer.data(), std::min(size, buffer.size()));
+
+        if(got < 0) {
+            if(errno == EINTR) continue;
+            return false;
+        }
+
+        if(got == 0) return false;
+        if(!WriteAll(buffer.data(), got)) return false;
+        size -= got;
+    }
+
+    return true;
+}
+
+bool FileWriter::Open(const std::string &filename) {
+    Close();
+
+    fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    failed = (fd < 0);
+
+    return !failed;
+}
+
+void FileWriter::Write(const void *data, size_t size) {
+    if(failed || (size == 0)) return;
+
+    if(size >= GALAMAKE_WRITE_GATHER_SIZE) {
+        if(!Flush() || !WriteAll((const uint8_t *)data, size)) failed = true;
+        return;
+    }
+
+    pending.push_back({(void *)data, size});
+    pendingBytes += size;
+
+    if((pending.size() >= IOV_MAX) || (pendingBytes >= GALAMAKE_WRITE_GATHER_SIZE))
+        Flush();
+}
+
+void FileWriter::WriteFile(const std::string &path, size_t size) {
+    if(failed || (size == 0)) return;
+    if(!Flush()) return;
+
+    const int inFd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(inFd < 0) { failed = true; return; }
+
+    if(!CopyFrom(inFd, size)) failed = true;
+
+    close(inFd);
+}
+
+bool FileWriter::Flush() {
+    if(failed) return false;
+
+    size_t first = 0;
+
+    while(first < pending.size()) {
+        const ssize_t written = writev(fd, pending.data() + first, pending.size() - first);
+
+        if(written < 0) {
+            if(errno == EINTR) continue;
+            failed = true;
+            break;
+        }
+
+        // Skip what was written; partly written buffers pick up where they left off.
+        size_t remaining = written;
+        while((first < pending.size()) && (remaining >= pending[first].iov_len)) {
+            remaining -= pending[first].iov_len;
+            first++;
+        }
+
+        if(remaining > 0) {
+            pending[first].iov_base = (uint8_t *)pending[first].iov_base + remaining;
+            pending[first].iov_len -= remaining;
+        }
+    }
+
+    pending.clear();
+    pendingBytes = 0;
+
+    return !failed;
+}
+
+bool FileWriter::Close() {
+    if(fd < 0) return !failed;
+
+    Flush();
+    if(close(fd) != 0) failed = true;
+    fd = -1;
+
+    return !failed;
+}
+
+FileWriter::FileWriter() {}
+
+FileWriter::~FileWriter() {
+    Close();
+}
+
+bool CloneFile(const std::string &from, const std::string &to) {
+    const int inFd = open(from.c_str(), O_RDONLY | O_CLOEXEC);
+    if(inFd < 0) return false;
+
+    struct stat info;
+    if(fstat(inFd, &info) != 0) { close(inFd); return false; }
+
+#ifdef FICLONE
+    const int outFd = open(to.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if(outFd < 0) { close(inFd); return false; }
+
+    const bool cloned = (ioctl(outFd, FICLONE, inFd) == 0);
+    const bool closed = (close(outFd) == 0);
+
+    if(cloned) { close(inFd); return closed; }
+#endif
+
+    close(inFd);
+
+    FileWriter writer;
+    if(!writer.Open(to)) return false;
+
+    writer.WriteFile(from, info.st_size);
+
+    return writer.Close();
+}
\ No newline at end of file